@@ -0,0 +1,50 @@
+#include "AllocationCounter.h"
+#include <cstdlib>
+#include <new>
+
+#ifdef MONEROMINER_COUNT_ALLOCATIONS
+
+static thread_local uint64_t threadAllocationCount = 0;
+
+void* operator new(std::size_t size) {
+    threadAllocationCount++;
+    if (size == 0) {
+        size = 1;
+    }
+    if (void* ptr = std::malloc(size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+uint64_t AllocationCounter::threadAllocations() {
+    return threadAllocationCount;
+}
+
+#else
+
+uint64_t AllocationCounter::threadAllocations() {
+    return 0;
+}
+
+#endif
\ No newline at end of file
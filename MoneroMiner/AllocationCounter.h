@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstdint>
+
+// Debug builds replace the global operator new/delete so heap allocations can
+// be counted per thread - used to check that the hash loop never allocates.
+#if defined(DEBUG) || defined(_DEBUG)
+#define MONEROMINER_COUNT_ALLOCATIONS
+#endif
+
+namespace AllocationCounter {
+    // Heap allocations made by the calling thread so far (always 0 in release builds)
+    uint64_t threadAllocations();
+}
\ No newline at end of file
@@ -0,0 +1,330 @@
+#include "Benchmark.h"
+#include "Config.h"
+#include "Globals.h"
+#include "Job.h"
+#include "LineBuffer.h"
+#include "MiningThreadData.h"
+#include "Platform.h"
+#include "RandomXManager.h"
+#include "Stratum.h"
+#include "ThreadPlacement.h"
+#include "Utils.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "picojson.h"
+
+namespace Benchmark {
+
+int run() {
+    const std::string seedHash(64, '0');
+    const int threadCount = config.numThreads > 0 ? config.numThreads : 1;
+    Utils::threadSafePrint("=== BENCHMARK: " + std::to_string(threadCount) + " threads, " +
+                           std::to_string(config.benchmarkSeconds) + " s ===", true);
+
+    auto initStart = std::chrono::steady_clock::now();
+    if (!RandomXManager::initialize(seedHash)) {
+        Utils::threadSafePrint("Benchmark: RandomX initialization failed", true);
+        return 1;
+    }
+    double initSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - initStart).count();
+    const bool fullMode = RandomXManager::getDataset() != nullptr;
+
+    // Zero blob, target easy enough that the result check is never the bottleneck
+    Job job(std::string(152, '0'), "benchmark", "ffffffff", 0, seedHash);
+    std::vector<unsigned int> cpus;
+    if (config.affinity != "none") {
+        cpus = ThreadPlacement::plan(Platform::getCpuTopology(), static_cast<size_t>(threadCount));
+    }
+
+    std::vector<MiningThreadData*> data;
+    for (int i = 0; i < threadCount; i++) {
+        data.push_back(new MiningThreadData(i));
+        data[i]->setNumaNode(static_cast<size_t>(i) % RandomXManager::getNumaNodeCount());
+    }
+
+    // Like the miner, each thread creates its VM after pinning itself
+    std::atomic<int> vmsReady{0};
+    std::atomic<int> vmsFailed{0};
+    std::atomic<bool> go{false};
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> threads;
+    auto vmStart = std::chrono::steady_clock::now();
+    for (int i = 0; i < threadCount; i++) {
+        threads.emplace_back([&, i]() {
+            if (static_cast<size_t>(i) < cpus.size()) Platform::pinCurrentThread({cpus[i]});
+            MiningThreadData* d = data[i];
+            bool ok = d->initializeVM() && d->prepareJob(job);
+            (ok ? vmsReady : vmsFailed).fetch_add(1);
+            while (!go.load()) std::this_thread::yield();
+            if (!ok || stop.load()) return;
+            uint32_t nonce = 0;
+            if (config.pipelineHashing) {
+                d->setNonce(nonce++);
+                d->beginHashPipeline();
+            }
+            while (!stop.load(std::memory_order_relaxed) && !shouldStop) {
+                d->setNonce(nonce++);
+                if (config.pipelineHashing) {
+                    d->calculateNextHashAndCheckTarget();
+                } else {
+                    d->calculateHashAndCheckTarget();
+                }
+            }
+            if (d->isHashPipelineActive()) d->finishHashPipeline();
+        });
+    }
+
+    while (vmsReady.load() + vmsFailed.load() < threadCount) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    double vmSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - vmStart).count();
+    if (vmsFailed.load() > 0) {
+        Utils::threadSafePrint("Benchmark: VM creation failed for " + std::to_string(vmsFailed.load()) + " thread(s)", true);
+        stop = true;
+    }
+    go = true;
+    if (stop) {
+        for (auto& thread : threads) thread.join();
+        for (auto* d : data) delete d;
+        RandomXManager::cleanup();
+        return 1;
+    }
+
+    auto hashStart = std::chrono::steady_clock::now();
+    std::this_thread::sleep_for(std::chrono::seconds(config.benchmarkSeconds));
+    stop = true;
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    double hashSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - hashStart).count();
+
+    uint64_t hashes = 0;
+    for (auto* d : data) {
+        hashes += d->getTotalHashCount();
+        delete d;
+    }
+    RandomXManager::cleanup();
+
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(2)
+       << "=== BENCHMARK RESULT ===\n"
+       << "Mode: " << (fullMode ? "full" : "light") << "\n"
+       << "RandomX init: " << initSeconds << " s\n"
+       << "VM creation: " << (vmSeconds * 1000.0) << " ms\n"
+       << "Hashes: " << hashes << " in " << hashSeconds << " s\n"
+       << "Hashrate: " << (hashes / hashSeconds) << " H/s";
+    Utils::threadSafePrint(ss.str(), true);
+    return 0;
+}
+
+// A captured pool session with the hex fields scrambled: job pushes
+// interleaved with submit and keepalive replies
+static const char* const SAMPLE_TRAFFIC =
+    "{\"jsonrpc\":\"2.0\",\"method\":\"job\",\"params\":{\"blob\":\"a4c123b1612dd272d1371c17149d439536b3216fdaeeb975729fae923d5a4fd12aabfe228f219e9cb0eb53f16947ccf25ec84d8dbc74254770f58904dba41ecccc3fc1626e53a13043b026c4\",\"job_id\":\"a7196b50ac2f86702824c1c0\",\"target\":\"b88d0600\",\"algo\":\"rx/0\",\"height\":3254127,\"seed_hash\":\"4b484e73cf575dcad6ba2b0aee0ca923732881584d8c4fa2815d2802827283e0\",\"next_seed_hash\":\"\"}}\n"
+    "{\"id\":12,\"jsonrpc\":\"2.0\",\"error\":null,\"result\":{\"status\":\"OK\"}}\n"
+    "{\"id\":13,\"jsonrpc\":\"2.0\",\"error\":null,\"result\":{\"status\":\"OK\"}}\n"
+    "{\"jsonrpc\":\"2.0\",\"method\":\"job\",\"params\":{\"blob\":\"8bbf33feff9243a8f506b40928b5b7a767c76fb008f86bebb2737f6a6f0fb23c6f5da2cec255404e4fb440034d6608697a8d41bed440e50454f31af3176813e02ea68ef786e4d3cea27d2693\",\"job_id\":\"99724caf4941d4072014b3ce\",\"target\":\"b88d0600\",\"algo\":\"rx/0\",\"height\":3254128,\"seed_hash\":\"4b484e73cf575dcad6ba2b0aee0ca923732881584d8c4fa2815d2802827283e0\",\"next_seed_hash\":\"ad84173581569969e58b081006f7e3dfc967a64cb14028d512c9791e558e08ba\"}}\r\n"
+    "{\"id\":14,\"jsonrpc\":\"2.0\",\"error\":{\"code\":-1,\"message\":\"Low difficulty share\"}}\n"
+    "{\"id\":15,\"jsonrpc\":\"2.0\",\"error\":null,\"result\":{\"status\":\"KEEPALIVED\"}}\n";
+
+static const size_t REPLAY_BYTES = 256ull * 1024 * 1024;  // Per framer and chunk size
+
+// The framing jobListener used before LineBuffer, kept as the baseline
+static size_t frameWithString(const std::string& traffic, size_t chunkSize, size_t passes, size_t& checksum) {
+    std::string buffer;
+    size_t lines = 0;
+    for (size_t pass = 0; pass < passes; pass++) {
+        for (size_t offset = 0; offset < traffic.size(); offset += chunkSize) {
+            buffer.append(traffic, offset, chunkSize);
+            size_t pos;
+            while ((pos = buffer.find('\n')) != std::string::npos) {
+                std::string message = buffer.substr(0, pos);
+                buffer.erase(0, pos + 1);
+                if (!message.empty() && message.back() == '\r') message.pop_back();
+                if (message.empty()) continue;
+                checksum += message.size();
+                lines++;
+            }
+        }
+    }
+    return lines;
+}
+
+// Stands in for recv() into writePtr(): copies at most maxBytes of traffic
+// from offset, never more than the buffer has room for. Returns the bytes
+// copied; zero means a line is longer than LineBuffer::CAPACITY.
+static size_t receive(LineBuffer& buffer, const std::string& traffic, size_t offset, size_t maxBytes) {
+    size_t length = (std::min)({maxBytes, traffic.size() - offset, buffer.writable()});
+    std::memcpy(buffer.writePtr(), traffic.data() + offset, length);
+    buffer.commit(length);
+    return length;
+}
+
+// False if a line of the traffic does not fit in the buffer
+static bool frameWithLineBuffer(const std::string& traffic, size_t chunkSize, size_t passes, size_t& checksum,
+                                size_t& lines) {
+    std::unique_ptr<LineBuffer> buffer(new LineBuffer());
+    lines = 0;
+    std::string_view line;
+    for (size_t pass = 0; pass < passes; pass++) {
+        for (size_t offset = 0; offset < traffic.size();) {
+            size_t received = receive(*buffer, traffic, offset, chunkSize);
+            if (received == 0) {
+                return false;
+            }
+            offset += received;
+            while (buffer->nextLine(line)) {
+                checksum += line.size();
+                lines++;
+            }
+        }
+    }
+    return true;
+}
+
+static const size_t PARSE_ROUNDS = 200000;  // Job messages decoded per parser
+
+// What processNewJob did for every push before the Stratum decoder
+static bool decodeWithPicojson(const std::string& line, size_t& checksum) {
+    picojson::value v;
+    std::string err = picojson::parse(v, line);
+    if (!err.empty() || !v.is<picojson::object>()) return false;
+    const picojson::object& obj = v.get<picojson::object>();
+    auto params = obj.find("params");
+    if (params == obj.end() || !params->second.is<picojson::object>()) return false;
+    const picojson::object& job = params->second.get<picojson::object>();
+    auto field = [&job](const char* name, bool number) -> const picojson::value* {
+        auto it = job.find(name);
+        if (it == job.end()) return nullptr;
+        bool matches = number ? it->second.is<double>() : it->second.is<std::string>();
+        return matches ? &it->second : nullptr;
+    };
+    const picojson::value* blobField = field("blob", false);
+    const picojson::value* jobIdField = field("job_id", false);
+    const picojson::value* targetField = field("target", false);
+    const picojson::value* heightField = field("height", true);
+    const picojson::value* seedField = field("seed_hash", false);
+    if (!blobField || !jobIdField || !targetField || !heightField || !seedField) return false;
+    std::string blobHex = blobField->get<std::string>();
+    std::string jobId = jobIdField->get<std::string>();
+    std::string target = targetField->get<std::string>();
+    uint64_t height = static_cast<uint64_t>(heightField->get<double>());
+    std::string seedHash = seedField->get<std::string>();
+    std::vector<uint8_t> blob = Utils::hexToBytes(blobHex);
+    checksum += blob.size() + jobId.size() + target.size() + seedHash.size() + height;
+    return true;
+}
+
+static bool decodeWithStratum(const std::string& line, uint8_t* blob, size_t& checksum) {
+    Stratum::JobFields job;
+    if (!Stratum::parseJobNotification(line, job)) return false;
+    size_t blobSize = Utils::hexToBytes(job.blob, blob, MiningConstants::MAX_BLOB_SIZE);
+    checksum += blobSize + job.jobId.size() + job.target.size() + job.seedHash.size() + job.height;
+    return true;
+}
+
+int runStratum() {
+    std::string traffic = SAMPLE_TRAFFIC;
+    std::string source = "built-in sample";
+    if (!config.stratumTrafficFile.empty()) {
+        std::ifstream file(config.stratumTrafficFile, std::ios::binary);
+        if (!file) {
+            Utils::threadSafePrint("Benchmark: cannot read " + config.stratumTrafficFile, true);
+            return 1;
+        }
+        traffic.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        source = config.stratumTrafficFile;
+    }
+    if (traffic.empty() || traffic.back() != '\n') traffic += '\n';
+
+    // Several captures back to back, the way a burst of pushes and replies lands
+    std::string burst;
+    while (burst.size() < 64 * 1024) burst += traffic;
+    const size_t passes = (std::max)(static_cast<size_t>(1), REPLAY_BYTES / burst.size());
+    const double megabytes = static_cast<double>(burst.size() * passes) / (1024.0 * 1024.0);
+    Utils::threadSafePrint("=== STRATUM BENCHMARK: " + source + ", " + std::to_string(traffic.size()) + " bytes replayed " +
+                           std::to_string(passes * (burst.size() / traffic.size())) + "x ===", true);
+
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(1) << "=== STRATUM BENCHMARK RESULT ===";
+    size_t checksum = 0;
+    for (size_t chunkSize : {static_cast<size_t>(1448), static_cast<size_t>(4096), static_cast<size_t>(65536)}) {
+        auto start = std::chrono::steady_clock::now();
+        size_t stringLines = frameWithString(burst, chunkSize, passes, checksum);
+        double stringSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        start = std::chrono::steady_clock::now();
+        size_t bufferLines = 0;
+        if (!frameWithLineBuffer(burst, chunkSize, passes, checksum, bufferLines)) {
+            Utils::threadSafePrint("Benchmark: the traffic has a line longer than " +
+                                   std::to_string(LineBuffer::CAPACITY) + " bytes", true);
+            return 1;
+        }
+        double bufferSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        if (stringLines != bufferLines) {
+            Utils::threadSafePrint("Benchmark: framers disagree (" + std::to_string(stringLines) + " vs " +
+                                   std::to_string(bufferLines) + " lines)", true);
+            return 1;
+        }
+        ss << "\nFraming, " << chunkSize << " byte reads: std::string " << (megabytes / stringSeconds) << " MB/s, "
+           << "LineBuffer " << (megabytes / bufferSeconds) << " MB/s ("
+           << (bufferLines / bufferSeconds / 1e6) << " M lines/s)";
+    }
+
+    // Job pushes from the capture, decoded the old and the new way
+    std::vector<std::string> jobLines;
+    {
+        std::unique_ptr<LineBuffer> buffer(new LineBuffer());
+        std::string_view line;
+        for (size_t offset = 0, received = 1; offset < traffic.size() && received > 0; offset += received) {
+            received = receive(*buffer, traffic, offset, LineBuffer::CAPACITY);
+            while (buffer->nextLine(line)) {
+                if (line.find("\"method\":\"job\"") != std::string_view::npos) jobLines.emplace_back(line);
+            }
+        }
+    }
+    if (jobLines.empty()) {
+        ss << "\nParsing: no job notifications in the traffic";
+    } else {
+        alignas(64) uint8_t blob[MiningConstants::MAX_BLOB_SIZE];
+        size_t picojsonDecoded = 0;
+        size_t stratumDecoded = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < PARSE_ROUNDS; i++) {
+            picojsonDecoded += decodeWithPicojson(jobLines[i % jobLines.size()], checksum);
+        }
+        double picojsonSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < PARSE_ROUNDS; i++) {
+            stratumDecoded += decodeWithStratum(jobLines[i % jobLines.size()], blob, checksum);
+        }
+        double stratumSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        ss << "\nJob parsing (" << jobLines.size() << " distinct pushes): picojson "
+           << (PARSE_ROUNDS / picojsonSeconds / 1e3) << " k jobs/s, Stratum decoder "
+           << (PARSE_ROUNDS / stratumSeconds / 1e3) << " k jobs/s";
+        size_t rounds = PARSE_ROUNDS / jobLines.size();
+        if (picojsonDecoded > stratumDecoded) {
+            ss << "\n  " << (picojsonDecoded - stratumDecoded) / rounds << " push(es) fell back to picojson";
+        } else if (stratumDecoded > picojsonDecoded) {
+            ss << "\n  " << (stratumDecoded - picojsonDecoded) / rounds
+               << " push(es) decoded by Stratum only (incomplete for picojson)";
+        }
+    }
+    ss << "\n(checksum " << checksum << ")";
+    Utils::threadSafePrint(ss.str(), true);
+    return 0;
+}
+
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+// Offline benchmark (--benchmark): builds the dataset for a fixed seed and
+// hashes a dummy blob on the configured threads, no pool involved. Reports
+// dataset init time and hashrate so init and hashing changes can be compared.
+namespace Benchmark {
+    // Exit code for main(): 0 on success, 1 if RandomX could not be set up
+    int run();
+
+    // --benchmark-stratum: replays recorded pool traffic through the receive
+    // path and reports framing and job decoding throughput against the old
+    // std::string framing and picojson parsing
+    int runStratum();
+}
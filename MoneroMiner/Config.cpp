@@ -1,11 +1,14 @@
 #include "Config.h"
 #include "Globals.h"
 #include "Platform.h"  // Replace windows.h with Platform.h
+#include "ThreadPlacement.h"
 #include <iostream>
 #include <string>
 #include <thread>
 #include <sstream>
 #include <fstream>
+#include <algorithm>
+#include <cstdlib>
 #include "Utils.h"
 
 Config::Config() {
@@ -16,6 +19,7 @@ void Config::setDefaults() {
     // Current pool (high difficulty):
     poolAddress = "xmr-us-east1.nanopool.org";
     poolPort = 10300;
+    backupPools.clear();
     walletAddress = "8C6hFb4Buo6dYwJiZEaFhyYhZTJaR4NyXSBzKMF1BnNKMGD92yeaY3a9PxuWp9bhTAh6dAXwqyyLfFxaPRct7j81L8t4iK2"; // Default test wallet
     workerName = "worker1";
     password = "x";  // Some pools require non-empty password
@@ -25,6 +29,28 @@ void Config::setDefaults() {
     useLogFile = false;
     logFileName = "monerominer.log";
     headlessMode = false; // Initialize headless mode flag
+    pipelineHashing = true; // randomx_calculate_hash_first/next/last
+    nicehash = false;
+    datasetDoubleBufferMiB = 0;  // Seed changes rebuild in place
+    numaReplicas = true;  // Only takes effect with more than one node
+    affinity = "auto";
+    cpuList.clear();
+    randomxMode = "auto";
+    hybridStart = true;
+    initThreads = 0;
+    datasetDir.clear();
+    datasetFiles = true;
+    benchmark = false;
+    benchmarkSeconds = 20;
+    benchmarkStratum = false;
+    stratumTrafficFile.clear();
+}
+
+std::vector<PoolEndpoint> Config::getPools() const {
+    std::vector<PoolEndpoint> pools;
+    pools.push_back(PoolEndpoint{poolAddress, poolPort});
+    pools.insert(pools.end(), backupPools.begin(), backupPools.end());
+    return pools;
 }
 
 bool Config::parseCommandLine(int argc, char* argv[]) {
@@ -57,6 +83,20 @@ bool Config::parseCommandLine(int argc, char* argv[]) {
                 poolAddress = poolStr;
             }
         }
+        else if (arg == "--backup-pool" && i + 1 < argc) {
+            std::string poolStr = argv[++i];
+            size_t colonPos = poolStr.rfind(':');
+            int port = colonPos != std::string::npos ? std::atoi(poolStr.c_str() + colonPos + 1) : 0;
+            if (colonPos == 0 || port <= 0) {
+                std::cerr << "Error: --backup-pool needs ADDRESS:PORT, got '" << poolStr << "'" << std::endl;
+                return false;
+            }
+            if (backupPools.size() + 1 >= 8) {  // EventLoop::MAX_SOCKETS
+                std::cerr << "Error: at most 7 backup pools" << std::endl;
+                return false;
+            }
+            backupPools.push_back(PoolEndpoint{poolStr.substr(0, colonPos), port});
+        }
         else if (arg == "--wallet" && i + 1 < argc) {
             walletAddress = argv[++i];
         }
@@ -70,19 +110,85 @@ bool Config::parseCommandLine(int argc, char* argv[]) {
             headlessMode = true;
             useLogFile = true; // Force log file in headless mode
         }
+        else if (arg == "--no-pipeline") {
+            pipelineHashing = false;
+        }
+        else if (arg == "--nicehash") {
+            nicehash = true;
+        }
+        else if (arg == "--dataset-double-buffer" && i + 1 < argc) {
+            datasetDoubleBufferMiB = std::stoull(argv[++i]);
+        }
+        else if (arg == "--no-numa") {
+            numaReplicas = false;
+        }
+        else if (arg == "--affinity" && i + 1 < argc) {
+            affinity = argv[++i];
+            if (affinity != "auto" && affinity != "none") {
+                std::cerr << "Error: --affinity must be auto or none" << std::endl;
+                return false;
+            }
+        }
+        else if (arg == "--randomx-mode" && i + 1 < argc) {
+            randomxMode = argv[++i];
+            if (randomxMode != "auto" && randomxMode != "full" && randomxMode != "light") {
+                std::cerr << "Error: --randomx-mode must be auto, full or light" << std::endl;
+                return false;
+            }
+        }
+        else if (arg == "--no-hybrid-start") {
+            hybridStart = false;
+        }
+        else if (arg == "--init-threads" && i + 1 < argc) {
+            initThreads = static_cast<unsigned int>(std::stoul(argv[++i]));
+        }
+        else if (arg == "--dataset-dir" && i + 1 < argc) {
+            datasetDir = argv[++i];
+        }
+        else if (arg == "--no-dataset-files") {
+            datasetFiles = false;
+        }
+        else if (arg == "--benchmark") {
+            benchmark = true;
+        }
+        else if (arg == "--benchmark-seconds" && i + 1 < argc) {
+            benchmarkSeconds = (std::max)(1, std::stoi(argv[++i]));
+        }
+        else if (arg == "--benchmark-stratum") {
+            benchmarkStratum = true;
+            if (i + 1 < argc && argv[i + 1][0] != '-') {
+                stratumTrafficFile = argv[++i];
+            }
+        }
+        else if (arg == "--cpu-list" && i + 1 < argc) {
+            cpuList = argv[++i];
+            if (Platform::parseCpuList(cpuList).empty()) {
+                std::cerr << "Error: invalid --cpu-list '" << cpuList << "'" << std::endl;
+                return false;
+            }
+        }
     }
     
     // ONLY auto-detect if user did NOT specify --threads
-    if (!threadCountSpecified && numThreads <= 1) {
+    if (!threadCountSpecified && !cpuList.empty()) {
+        numThreads = static_cast<uint32_t>(Platform::parseCpuList(cpuList).size());  // One thread per listed CPU
+    }
+    else if (!threadCountSpecified && numThreads <= 1) {
         unsigned int logicalProcessors = Platform::getLogicalProcessors();
 
         // Use the majority of logical processors but leave one core for the system.
         // This yields: 3 threads on 4-core, 7 on 8-core, 15 on 16-core, 23 on 24-core, etc.
         unsigned int recommended = (logicalProcessors > 1) ? (logicalProcessors - 1) : 1;
+
+        // ...and no more than the L3 caches hold scratchpads for
+        size_t l3Threads = ThreadPlacement::recommendedThreads(Platform::getCpuTopology());
+        if (l3Threads > 0 && l3Threads < recommended) {
+            recommended = static_cast<unsigned int>(l3Threads);
+        }
         numThreads = static_cast<int>(recommended);
         std::cout << "Auto-detected " << logicalProcessors
-                  << " logical processors, using " << numThreads
-                  << " mining threads (leaving 1 thread for system)" << std::endl;
+                  << " logical processors (L3 fits " << l3Threads << " threads), using " << numThreads
+                  << " mining threads" << std::endl;
     }
     
     // Set default worker name based on machine name if not specified
@@ -122,11 +228,22 @@ bool validateConfig(const Config& config) {
 void Config::printConfig() const {
     std::cout << "Current configuration:" << std::endl;
     std::cout << "Pool address: " << poolAddress << ":" << poolPort << std::endl;
+    for (const PoolEndpoint& backup : backupPools) {
+        std::cout << "Backup pool: " << backup.host << ":" << backup.port << std::endl;
+    }
     std::cout << "Wallet: " << walletAddress << std::endl;
     std::cout << "Worker name: " << workerName << std::endl;
     std::cout << "User agent: " << userAgent << std::endl;
     std::cout << "Number of threads: " << numThreads << std::endl;
     std::cout << "Debug mode: " << (debugMode ? "enabled" : "disabled") << std::endl;
+    std::cout << "Pipelined hashing: " << (pipelineHashing ? "enabled" : "disabled") << std::endl;
+    std::cout << "NiceHash nonce prefix: " << (nicehash ? "reserved" : "disabled") << std::endl;
+    std::cout << "Dataset double buffer: " << (datasetDoubleBufferMiB ? std::to_string(datasetDoubleBufferMiB) + " MiB" : "disabled") << std::endl;
+    std::cout << "NUMA dataset replicas: " << (numaReplicas ? "enabled" : "disabled") << std::endl;
+    std::cout << "Thread affinity: " << (cpuList.empty() ? affinity : "cpu-list " + cpuList) << std::endl;
+    std::cout << "RandomX mode: " << randomxMode << (hybridStart ? " (hybrid start)" : "") << std::endl;
+    std::cout << "Dataset init threads: " << (initThreads ? std::to_string(initThreads) : "auto") << std::endl;
+    std::cout << "Dataset files: " << (!datasetFiles ? "disabled" : datasetDir.empty() ? "working directory" : datasetDir) << std::endl;
     std::cout << "Log file: " << logFileName << std::endl;
     std::cout << std::endl;
 }
@@ -140,10 +257,25 @@ void Config::printUsage() const {
     std::cout << "  --logfile              Enable logging to file" << std::endl;
     std::cout << "  --threads N            Number of mining threads" << std::endl;
     std::cout << "  --pool ADDRESS:PORT    Pool address and port" << std::endl;
+    std::cout << "  --backup-pool ADDR:PORT  Failover pool, repeat for more (tried in order)" << std::endl;
     std::cout << "  --wallet ADDRESS       Your Monero wallet address" << std::endl;
     std::cout << "  --worker NAME          Worker name" << std::endl;
     std::cout << "  --password PASS        Pool password (default: x)" << std::endl;
     std::cout << "  --headless             Enable headless mode (no GUI)" << std::endl;
+    std::cout << "  --no-pipeline          Disable pipelined hashing (hash one nonce at a time)" << std::endl;
+    std::cout << "  --nicehash             Keep the pool's top nonce byte (NiceHash-style pools)" << std::endl;
+    std::cout << "  --dataset-double-buffer MIB  Memory for building the next dataset in the background" << std::endl;
+    std::cout << "  --no-numa              Share one dataset across NUMA nodes (no replicas, no pinning)" << std::endl;
+    std::cout << "  --affinity MODE        auto: pin threads by cache/core topology, none: no pinning" << std::endl;
+    std::cout << "  --cpu-list LIST        Pin thread N to the Nth CPU of LIST, e.g. 0,2,4-7" << std::endl;
+    std::cout << "  --randomx-mode MODE    auto: full if memory allows, full: 2GB dataset, light: 256MB cache" << std::endl;
+    std::cout << "  --no-hybrid-start      Wait for the dataset instead of hashing in light mode meanwhile" << std::endl;
+    std::cout << "  --init-threads N       Threads for dataset initialization (default: all CPUs but one)" << std::endl;
+    std::cout << "  --dataset-dir DIR      Where dataset files are saved (default: working directory)" << std::endl;
+    std::cout << "  --no-dataset-files     Never load or save dataset files, always build in memory" << std::endl;
+    std::cout << "  --benchmark            Time dataset init and hashing offline, no pool" << std::endl;
+    std::cout << "  --benchmark-seconds N  Hashing time of --benchmark (default: 20)" << std::endl;
+    std::cout << "  --benchmark-stratum [FILE]  Replay recorded pool traffic through the receive path" << std::endl;
     std::cout << "\nExample:" << std::endl;
     std::cout << "  MoneroMiner.exe --wallet YOUR_WALLET --threads 4" << std::endl;
 }
\ No newline at end of file
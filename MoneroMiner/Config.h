@@ -2,12 +2,19 @@
 
 #include <string>
 #include <cstdint>
+#include <vector>
+
+struct PoolEndpoint {
+    std::string host;
+    int port;
+};
 
 class Config {
 public:
     // Configuration settings
     std::string poolAddress;
     int poolPort;  
+    std::vector<PoolEndpoint> backupPools;  // Failover order after poolAddress:poolPort
     std::string walletAddress;
     std::string workerName;
     std::string password;
@@ -18,12 +25,28 @@ public:
     std::string logFileName;
     bool threadCountSpecified = false; // Track if user set --threads
     bool headlessMode;
+    bool pipelineHashing;  // Overlap next input's setup with current hash (default on)
+    bool nicehash;         // Pool owns the top nonce byte - only search the low 24 bits
+    uint64_t datasetDoubleBufferMiB;  // Extra memory for building the next seed's dataset (0 = off)
+    bool numaReplicas;     // One dataset copy per NUMA node, threads pinned to their node
+    std::string affinity;  // "auto": pin threads by L3/core topology, "none": leave to the OS
+    std::string cpuList;   // Explicit CPU per thread ("0,2,4-7"), overrides affinity
+    std::string randomxMode;  // "auto" (full if memory allows), "full" or "light"
+    bool hybridStart;      // Hash in light mode while the full dataset is built
+    unsigned int initThreads;  // Dataset initialization threads (0 = all CPUs but one)
+    std::string datasetDir;    // Where per-seed dataset files are kept, "" = working directory
+    bool datasetFiles;         // Load and save datasets there at all
+    bool benchmark;        // Offline init + hashrate benchmark instead of mining
+    int benchmarkSeconds;  // Hashing time of the benchmark
+    bool benchmarkStratum;           // Replay pool traffic through the receive path instead of mining
+    std::string stratumTrafficFile;  // Recorded traffic for it, "" = built-in sample
 
     // Constructor
     Config();
 
     // Methods
     void setDefaults();
+    std::vector<PoolEndpoint> getPools() const;  // Primary first, then the backups
     bool parseCommandLine(int argc, char* argv[]);
     void printConfig() const;
     
@@ -0,0 +1,364 @@
+#include "DatasetStore.h"
+#include "Platform.h"
+#include "Utils.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <thread>
+#include <vector>
+
+#ifndef PLATFORM_WINDOWS
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+namespace DatasetStore {
+
+namespace {
+    constexpr char MAGIC[8] = {'M', 'M', 'R', 'X', 'D', 'S', 'E', 'T'};
+    constexpr uint32_t FORMAT_VERSION = 1;
+    constexpr char ALGORITHM[16] = "rx/0";
+    constexpr size_t SAMPLE_ITEMS = 16;
+    constexpr char FILE_PREFIX[] = "randomx_dataset_";
+    constexpr char FILE_SUFFIX[] = ".bin";
+
+    struct FileHeader {
+        char magic[8];
+        uint32_t formatVersion;
+        uint32_t itemSize;
+        char algorithm[16];
+        uint8_t seedHash[32];
+        uint64_t itemCount;
+        uint64_t checksum;  // Over the item data, see combineChecksums
+        uint8_t reserved[48];
+    };
+    static_assert(sizeof(FileHeader) == 128, "FileHeader layout is part of the file format");
+
+    // Positional I/O, so every worker reads/writes its own blocks on one handle
+    class File {
+    public:
+        File() = default;
+        File(const File&) = delete;
+        File& operator=(const File&) = delete;
+        ~File() { close(); }
+
+#ifdef PLATFORM_WINDOWS
+        bool open(const std::string& path, bool forWrite) {
+            handle = CreateFileA(path.c_str(), forWrite ? GENERIC_WRITE : GENERIC_READ, FILE_SHARE_READ, nullptr,
+                forWrite ? CREATE_ALWAYS : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            return handle != INVALID_HANDLE_VALUE;
+        }
+
+        void close() {
+            if (handle != INVALID_HANDLE_VALUE) {
+                CloseHandle(handle);
+                handle = INVALID_HANDLE_VALUE;
+            }
+        }
+
+        bool readAt(void* buffer, size_t size, uint64_t offset) {
+            uint8_t* out = static_cast<uint8_t*>(buffer);
+            while (size > 0) {
+                OVERLAPPED position = {};
+                position.Offset = static_cast<DWORD>(offset);
+                position.OffsetHigh = static_cast<DWORD>(offset >> 32);
+                DWORD done = 0;
+                if (!ReadFile(handle, out, static_cast<DWORD>(size), &done, &position) || done == 0) return false;
+                out += done; size -= done; offset += done;
+            }
+            return true;
+        }
+
+        bool writeAt(const void* buffer, size_t size, uint64_t offset) {
+            const uint8_t* in = static_cast<const uint8_t*>(buffer);
+            while (size > 0) {
+                OVERLAPPED position = {};
+                position.Offset = static_cast<DWORD>(offset);
+                position.OffsetHigh = static_cast<DWORD>(offset >> 32);
+                DWORD done = 0;
+                if (!WriteFile(handle, in, static_cast<DWORD>(size), &done, &position) || done == 0) return false;
+                in += done; size -= done; offset += done;
+            }
+            return true;
+        }
+
+    private:
+        HANDLE handle = INVALID_HANDLE_VALUE;
+#else
+        bool open(const std::string& path, bool forWrite) {
+            fd = forWrite ? ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644) : ::open(path.c_str(), O_RDONLY);
+            return fd >= 0;
+        }
+
+        void close() {
+            if (fd >= 0) {
+                ::close(fd);
+                fd = -1;
+            }
+        }
+
+        bool readAt(void* buffer, size_t size, uint64_t offset) {
+            uint8_t* out = static_cast<uint8_t*>(buffer);
+            while (size > 0) {
+                ssize_t done = pread(fd, out, size, static_cast<off_t>(offset));
+                if (done <= 0) return false;
+                out += done; size -= static_cast<size_t>(done); offset += static_cast<uint64_t>(done);
+            }
+            return true;
+        }
+
+        bool writeAt(const void* buffer, size_t size, uint64_t offset) {
+            const uint8_t* in = static_cast<const uint8_t*>(buffer);
+            while (size > 0) {
+                ssize_t done = pwrite(fd, in, size, static_cast<off_t>(offset));
+                if (done <= 0) return false;
+                in += done; size -= static_cast<size_t>(done); offset += static_cast<uint64_t>(done);
+            }
+            return true;
+        }
+
+    private:
+        int fd = -1;
+#endif
+    };
+
+    inline uint64_t rotl64(uint64_t x, int r) {
+        return (x << r) | (x >> (64 - r));
+    }
+
+    // Four independent lanes keep the multiplies pipelined; runs at memory speed
+    uint64_t checksumBlock(const uint8_t* data, size_t size) {
+        constexpr uint64_t PRIME = 0x9E3779B97F4A7C15ull;
+        uint64_t lanes[4] = {PRIME, PRIME + 1, PRIME + 2, PRIME + 3};
+        size_t words = size / sizeof(uint64_t);
+        for (size_t i = 0; i + 4 <= words; i += 4) {
+            for (size_t lane = 0; lane < 4; lane++) {
+                uint64_t word;
+                std::memcpy(&word, data + (i + lane) * sizeof(uint64_t), sizeof(word));
+                lanes[lane] = rotl64(lanes[lane] ^ word, 31) * PRIME;
+            }
+        }
+        uint64_t hash = size;
+        for (uint64_t lane : lanes) {
+            hash = rotl64(hash ^ lane, 27) * PRIME;
+        }
+        return hash;
+    }
+
+    // Blocks are fixed-size, so the result does not depend on the thread count
+    uint64_t combineChecksums(const std::vector<uint64_t>& blockSums) {
+        uint64_t hash = 0;
+        for (uint64_t sum : blockSums) {
+            hash = rotl64(hash ^ sum, 23) * 0xC2B2AE3D27D4EB4Full;
+        }
+        return hash;
+    }
+
+    // Runs work(block) for every block over numThreads workers (the caller is
+    // one of them); stops handing out blocks after the first failure
+    template <typename Work>
+    bool forEachBlock(size_t blockCount, unsigned int numThreads, bool lowPriority, Work work) {
+        std::atomic<size_t> nextBlock{0};
+        std::atomic<bool> failed{false};
+        auto worker = [&]() {
+            for (size_t block = nextBlock.fetch_add(1); block < blockCount && !failed.load(std::memory_order_relaxed);
+                 block = nextBlock.fetch_add(1)) {
+                if (!work(block)) failed.store(true);
+            }
+        };
+
+        numThreads = static_cast<unsigned int>((std::min<size_t>)((std::max)(numThreads, 1u), blockCount));
+        std::vector<std::thread> threads;
+        for (unsigned int t = 1; t < numThreads; t++) {
+            threads.emplace_back([&worker, lowPriority]() {
+                if (lowPriority) Platform::lowerCurrentThreadPriority();
+                worker();
+            });
+        }
+        worker();
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        return !failed.load();
+    }
+
+    // Recompute a few items from the cache: catches a file that is intact but
+    // was produced for another seed or by an incompatible RandomX build
+    bool sampleItemsMatch(randomx_cache* seedCache, randomx_dataset* dataset, uint64_t itemCount) {
+        uint8_t* items = static_cast<uint8_t*>(randomx_get_dataset_memory(dataset));
+        for (size_t sample = 0; sample < SAMPLE_ITEMS; sample++) {
+            unsigned long item = static_cast<unsigned long>((itemCount - 1) * sample / (SAMPLE_ITEMS - 1));
+            uint8_t* itemData = items + static_cast<uint64_t>(item) * RANDOMX_DATASET_ITEM_SIZE;
+            uint8_t stored[RANDOMX_DATASET_ITEM_SIZE];
+            std::memcpy(stored, itemData, sizeof(stored));
+            randomx_init_dataset(dataset, seedCache, item, 1);  // Rewrites the item in place
+            if (std::memcmp(stored, itemData, sizeof(stored)) != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    double secondsSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count() / 1000.0;
+    }
+}
+
+std::string pathFor(const std::string& directory, const std::string& seedHash) {
+    std::string fileName = FILE_PREFIX + seedHash.substr(0, 16) + FILE_SUFFIX;
+    return directory.empty() ? fileName : (std::filesystem::path(directory) / fileName).string();
+}
+
+bool save(const std::string& path, const std::string& seedHash, randomx_dataset* dataset,
+          unsigned int numThreads, bool lowPriority, const std::atomic<bool>* abort) {
+    std::vector<uint8_t> seedBytes = Utils::hexToBytes(seedHash);
+    const uint8_t* data = dataset ? static_cast<const uint8_t*>(randomx_get_dataset_memory(dataset)) : nullptr;
+    if (!data || seedBytes.size() != 32) {
+        return false;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    uint64_t itemCount = randomx_dataset_item_count();
+    uint64_t dataSize = itemCount * RANDOMX_DATASET_ITEM_SIZE;
+    size_t blockCount = static_cast<size_t>((dataSize + BLOCK_SIZE - 1) / BLOCK_SIZE);
+    std::vector<uint64_t> blockSums(blockCount);
+    std::string tmpPath = path + ".tmp";
+    std::error_code ec;
+    std::filesystem::path directory = std::filesystem::path(path).parent_path();
+    if (!directory.empty()) {
+        std::filesystem::create_directories(directory, ec);
+    }
+
+    {
+        File file;
+        if (!file.open(tmpPath, true)) {
+            Utils::threadSafePrint("Cannot write dataset file " + tmpPath, true);
+            return false;
+        }
+
+        bool written = forEachBlock(blockCount, numThreads, lowPriority, [&](size_t block) {
+            if (abort && abort->load(std::memory_order_relaxed)) return false;
+            uint64_t offset = block * BLOCK_SIZE;
+            size_t size = static_cast<size_t>((std::min)(BLOCK_SIZE, dataSize - offset));
+            blockSums[block] = checksumBlock(data + offset, size);
+            return file.writeAt(data + offset, size, DATA_OFFSET + offset);
+        });
+
+        // Header last: a valid header only ever sits in front of a complete payload
+        FileHeader header = {};
+        std::memcpy(header.magic, MAGIC, sizeof(header.magic));
+        header.formatVersion = FORMAT_VERSION;
+        header.itemSize = RANDOMX_DATASET_ITEM_SIZE;
+        std::memcpy(header.algorithm, ALGORITHM, sizeof(header.algorithm));
+        std::memcpy(header.seedHash, seedBytes.data(), sizeof(header.seedHash));
+        header.itemCount = itemCount;
+        header.checksum = combineChecksums(blockSums);
+
+        if (!written || !file.writeAt(&header, sizeof(header), 0)) {
+            if (!abort || !abort->load()) {
+                Utils::threadSafePrint("Failed writing dataset file " + tmpPath, true);
+            }
+            file.close();
+            std::filesystem::remove(tmpPath, ec);
+            return false;
+        }
+    }
+
+    std::filesystem::rename(tmpPath, path, ec);
+    if (ec) {
+        std::filesystem::remove(tmpPath, ec);
+        return false;
+    }
+
+    Utils::threadSafePrint("Dataset saved to " + path + " in " + std::to_string(secondsSince(start)) + " seconds", true);
+    return true;
+}
+
+bool load(const std::string& path, const std::string& seedHash, randomx_cache* seedCache,
+          randomx_dataset* dataset, unsigned int numThreads, bool lowPriority) {
+    std::vector<uint8_t> seedBytes = Utils::hexToBytes(seedHash);
+    uint8_t* data = dataset ? static_cast<uint8_t*>(randomx_get_dataset_memory(dataset)) : nullptr;
+    if (!data || !seedCache || seedBytes.size() != 32) {
+        return false;
+    }
+
+    File file;
+    if (!file.open(path, false)) {
+        return false;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    uint64_t itemCount = randomx_dataset_item_count();
+    FileHeader header = {};
+    if (!file.readAt(&header, sizeof(header), 0) ||
+        std::memcmp(header.magic, MAGIC, sizeof(header.magic)) != 0 ||
+        header.formatVersion != FORMAT_VERSION ||
+        header.itemSize != RANDOMX_DATASET_ITEM_SIZE ||
+        std::memcmp(header.algorithm, ALGORITHM, sizeof(header.algorithm)) != 0 ||
+        std::memcmp(header.seedHash, seedBytes.data(), sizeof(header.seedHash)) != 0 ||
+        header.itemCount != itemCount) {
+        Utils::threadSafePrint("Dataset file " + path + " has another format, seed or size - rebuilding", true);
+        return false;
+    }
+
+    uint64_t dataSize = itemCount * RANDOMX_DATASET_ITEM_SIZE;
+    size_t blockCount = static_cast<size_t>((dataSize + BLOCK_SIZE - 1) / BLOCK_SIZE);
+    std::vector<uint64_t> blockSums(blockCount);
+    bool read = forEachBlock(blockCount, numThreads, lowPriority, [&](size_t block) {
+        uint64_t offset = block * BLOCK_SIZE;
+        size_t size = static_cast<size_t>((std::min)(BLOCK_SIZE, dataSize - offset));
+        if (!file.readAt(data + offset, size, DATA_OFFSET + offset)) return false;
+        blockSums[block] = checksumBlock(data + offset, size);
+        return true;
+    });
+    if (!read) {
+        Utils::threadSafePrint("Dataset file " + path + " is truncated - rebuilding", true);
+        return false;
+    }
+    if (combineChecksums(blockSums) != header.checksum) {
+        Utils::threadSafePrint("Dataset file " + path + " failed its checksum - rebuilding", true);
+        return false;
+    }
+    if (!sampleItemsMatch(seedCache, dataset, itemCount)) {
+        Utils::threadSafePrint("Dataset file " + path + " does not match this RandomX build - rebuilding", true);
+        return false;
+    }
+
+    Utils::threadSafePrint("Dataset loaded from " + path + " in " + std::to_string(secondsSince(start)) + " seconds", true);
+    return true;
+}
+
+void prune(const std::string& directory, const std::vector<std::string>& keepSeeds) {
+    std::vector<std::string> keepNames;
+    for (const std::string& seedHash : keepSeeds) {
+        if (!seedHash.empty()) {
+            keepNames.push_back(std::filesystem::path(pathFor("", seedHash)).filename().string());
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::directory_iterator it(directory.empty() ? std::filesystem::path(".") : std::filesystem::path(directory), ec);
+    std::vector<std::filesystem::path> stale;
+    for (; !ec && it != std::filesystem::directory_iterator(); it.increment(ec)) {
+        std::string name = it->path().filename().string();
+        size_t prefixLength = sizeof(FILE_PREFIX) - 1;
+        size_t suffixLength = sizeof(FILE_SUFFIX) - 1;
+        if (name.size() <= prefixLength + suffixLength ||
+            name.compare(0, prefixLength, FILE_PREFIX) != 0 ||
+            name.compare(name.size() - suffixLength, suffixLength, FILE_SUFFIX) != 0 ||
+            std::find(keepNames.begin(), keepNames.end(), name) != keepNames.end()) {
+            continue;
+        }
+        stale.push_back(it->path());
+    }
+
+    for (const std::filesystem::path& path : stale) {
+        if (std::filesystem::remove(path, ec)) {
+            Utils::threadSafePrint("Removed old dataset file " + path.string(), true);
+        }
+    }
+}
+
+} // namespace DatasetStore
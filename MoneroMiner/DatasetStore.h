@@ -0,0 +1,35 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "randomx.h"
+
+// On-disk dataset cache, one file per seed hash. The file starts with a
+// header (format, algorithm, seed, item count, checksum) followed by the raw
+// dataset items at DATA_OFFSET. Both directions run over several threads in
+// fixed-size blocks, reading/writing straight from RandomX's own (huge-page)
+// dataset allocation, and the checksum is computed per block on the way.
+namespace DatasetStore {
+    constexpr uint64_t DATA_OFFSET = 4096;
+    constexpr uint64_t BLOCK_SIZE = 64ull << 20;
+
+    // randomx_dataset_<first 16 hex digits of seed>.bin in directory ("" = working directory)
+    std::string pathFor(const std::string& directory, const std::string& seedHash);
+
+    // Writes to path + ".tmp" and renames, so a crash never leaves a half
+    // file; creates the file's directory if needed. Setting abort stops the
+    // write and removes the temporary file.
+    bool save(const std::string& path, const std::string& seedHash, randomx_dataset* dataset,
+              unsigned int numThreads, bool lowPriority, const std::atomic<bool>* abort = nullptr);
+
+    // Fails on a missing file, a header for another seed/version/size, a
+    // checksum mismatch, or sample items that do not match seedCache
+    bool load(const std::string& path, const std::string& seedHash, randomx_cache* seedCache,
+              randomx_dataset* dataset, unsigned int numThreads, bool lowPriority);
+
+    // Deletes the dataset files in directory of every seed not in keepSeeds.
+    // Files being written (.tmp) are left alone.
+    void prune(const std::string& directory, const std::vector<std::string>& keepSeeds);
+}
\ No newline at end of file
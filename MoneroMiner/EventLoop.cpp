@@ -0,0 +1,180 @@
+#include "EventLoop.h"
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#ifdef PLATFORM_LINUX
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#endif
+
+EventLoop::~EventLoop() {
+    close();
+}
+
+EventLoop::Watched* EventLoop::find(socket_t socket) {
+    for (size_t i = 0; i < watchedCount; i++) {
+        if (watched[i].socket == socket) return &watched[i];
+    }
+    return nullptr;
+}
+
+unsigned EventLoop::events(socket_t socket) const {
+    for (size_t i = 0; i < watchedCount; i++) {
+        if (watched[i].socket == socket) return watched[i].events;
+    }
+    return NONE;
+}
+
+#ifdef PLATFORM_LINUX
+
+bool EventLoop::open() {
+    if (epollFd >= 0) return true;
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epollFd < 0 || wakeFd < 0) {
+        close();
+        return false;
+    }
+    epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.fd = wakeFd;
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &event) != 0) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void EventLoop::close() {
+    if (epollFd >= 0) ::close(epollFd);
+    if (wakeFd >= 0) ::close(wakeFd);
+    epollFd = wakeFd = -1;
+    watchedCount = 0;
+}
+
+bool EventLoop::watch(socket_t socket, bool writeInterest) {
+    unwatch(socket);
+    if (watchedCount == MAX_SOCKETS) return false;
+    epoll_event event = {};
+    event.events = EPOLLIN | EPOLLRDHUP | (writeInterest ? EPOLLOUT : 0u);
+    event.data.fd = socket;
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, socket, &event) != 0) {
+        return false;
+    }
+    watched[watchedCount++] = Watched{socket, writeInterest, NONE};
+    return true;
+}
+
+void EventLoop::unwatch(socket_t socket) {
+    Watched* entry = find(socket);
+    if (entry == nullptr) return;
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, socket, nullptr);  // Fails harmlessly once closed
+    *entry = watched[--watchedCount];
+}
+
+bool EventLoop::updateInterest(const Watched& entry) {
+    epoll_event event = {};
+    event.events = EPOLLIN | EPOLLRDHUP | (entry.writeInterest ? EPOLLOUT : 0u);
+    event.data.fd = entry.socket;
+    return epoll_ctl(epollFd, EPOLL_CTL_MOD, entry.socket, &event) == 0;
+}
+
+unsigned EventLoop::wait(int timeoutMs) {
+    for (size_t i = 0; i < watchedCount; i++) watched[i].events = NONE;
+
+    epoll_event events[MAX_SOCKETS + 1];
+    int count = epoll_wait(epollFd, events, static_cast<int>(MAX_SOCKETS + 1), timeoutMs);
+    unsigned result = NONE;
+    for (int i = 0; i < count; i++) {
+        if (events[i].data.fd == wakeFd) {
+            // Cleared before draining: a wake() racing with this re-arms the fd
+            wakePending.store(false, std::memory_order_release);
+            uint64_t value;
+            while (read(wakeFd, &value, sizeof(value)) > 0) {}
+            result |= WOKEN;
+            continue;
+        }
+        Watched* entry = find(events[i].data.fd);
+        if (entry == nullptr) continue;
+        if (events[i].events & (EPOLLIN | EPOLLRDHUP)) entry->events |= READABLE;
+        if (events[i].events & EPOLLOUT) entry->events |= WRITABLE;
+        if (events[i].events & (EPOLLERR | EPOLLHUP)) entry->events |= HANGUP;
+    }
+    return result;
+}
+
+void EventLoop::wake() {
+    if (wakeFd < 0 || wakePending.exchange(true, std::memory_order_acq_rel)) {
+        return;  // Not open, or the loop has not consumed the previous wake yet
+    }
+    uint64_t one = 1;
+    ssize_t written = write(wakeFd, &one, sizeof(one));
+    (void)written;
+}
+
+#else
+
+bool EventLoop::open() {
+    return true;
+}
+
+void EventLoop::close() {
+    watchedCount = 0;
+}
+
+bool EventLoop::watch(socket_t socket, bool writeInterest) {
+    unwatch(socket);
+    if (watchedCount == MAX_SOCKETS) return false;
+    watched[watchedCount++] = Watched{socket, writeInterest, NONE};
+    return true;
+}
+
+void EventLoop::unwatch(socket_t socket) {
+    Watched* entry = find(socket);
+    if (entry != nullptr) *entry = watched[--watchedCount];
+}
+
+bool EventLoop::updateInterest(const Watched&) {
+    return true;  // select() takes the sets on every wait
+}
+
+unsigned EventLoop::wait(int timeoutMs) {
+    int waitMs = timeoutMs < 0 ? WAKE_POLL_MS : (std::min)(timeoutMs, WAKE_POLL_MS);
+    for (size_t i = 0; i < watchedCount; i++) watched[i].events = NONE;
+    if (watchedCount > 0) {
+        fd_set readSet, writeSet, errorSet;
+        FD_ZERO(&readSet);
+        FD_ZERO(&writeSet);
+        FD_ZERO(&errorSet);
+        for (size_t i = 0; i < watchedCount; i++) {
+            FD_SET(watched[i].socket, &readSet);
+            FD_SET(watched[i].socket, &errorSet);  // Also a failed connect on Windows
+            if (watched[i].writeInterest) FD_SET(watched[i].socket, &writeSet);
+        }
+        struct timeval timeout = { 0, waitMs * 1000 };
+        if (select(0, &readSet, &writeSet, &errorSet, &timeout) > 0) {
+            for (size_t i = 0; i < watchedCount; i++) {
+                if (FD_ISSET(watched[i].socket, &readSet)) watched[i].events |= READABLE;
+                if (FD_ISSET(watched[i].socket, &writeSet)) watched[i].events |= WRITABLE;
+                if (FD_ISSET(watched[i].socket, &errorSet)) watched[i].events |= HANGUP;
+            }
+        }
+    } else {
+        std::this_thread::sleep_for(std::chrono::milliseconds(waitMs));
+    }
+    return wakePending.exchange(false, std::memory_order_acq_rel) ? WOKEN : NONE;
+}
+
+void EventLoop::wake() {
+    wakePending.store(true, std::memory_order_release);
+}
+
+#endif
+
+void EventLoop::setWriteInterest(socket_t socket, bool enabled) {
+    Watched* entry = find(socket);
+    if (entry == nullptr || entry->writeInterest == enabled) return;
+    entry->writeInterest = enabled;
+    updateInterest(*entry);
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "Platform.h"
+#include <atomic>
+#include <cstddef>
+
+// Readiness loop for the pool connections, driven by a single thread. On
+// Linux it is epoll plus an eventfd that other threads write to wake it (a
+// queued share, shutdown), so idle connections cost no wakeups at all.
+// Windows has no equivalent that mixes sockets and events, so there it is
+// select() with the wait capped at WAKE_POLL_MS to notice wake().
+class EventLoop {
+public:
+    enum Event : unsigned {
+        NONE = 0,
+        READABLE = 1,  // Data or EOF to read
+        WRITABLE = 2,  // Only reported while write interest is on (also: connect finished)
+        HANGUP = 4,    // Socket error or hangup
+        WOKEN = 8,     // wake() was called since the last wait
+    };
+
+    static constexpr int WAKE_POLL_MS = 10;
+    static constexpr size_t MAX_SOCKETS = 8;  // One connection per configured pool
+
+    EventLoop() = default;
+    ~EventLoop();
+    EventLoop(const EventLoop&) = delete;
+    EventLoop& operator=(const EventLoop&) = delete;
+
+    bool open();
+    void close();
+
+    // Up to MAX_SOCKETS sockets; watch with write interest to see a
+    // non-blocking connect() complete
+    bool watch(socket_t socket, bool writeInterest = false);
+    void unwatch(socket_t socket);
+    void setWriteInterest(socket_t socket, bool enabled);  // While a send is incomplete
+
+    // Blocks until an event or timeoutMs passed (-1: no timeout). Returns
+    // WOKEN or NONE; per-socket bits are read with events() afterwards.
+    unsigned wait(int timeoutMs);
+    unsigned events(socket_t socket) const;  // From the last wait()
+
+    // Any thread. Wakes coalesce until the loop thread sees them.
+    void wake();
+
+private:
+    struct Watched {
+        socket_t socket;
+        bool writeInterest;
+        unsigned events;
+    };
+
+    Watched* find(socket_t socket);
+    bool updateInterest(const Watched& entry);
+
+    Watched watched[MAX_SOCKETS];
+    size_t watchedCount = 0;
+    std::atomic<bool> wakePending{false};
+#ifdef PLATFORM_LINUX
+    int epollFd = -1;
+    int wakeFd = -1;
+#endif
+};
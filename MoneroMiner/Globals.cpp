@@ -28,7 +28,6 @@ std::queue<Job> jobQueue;
 std::string currentBlobHex;
 std::string currentTargetHex;
 std::string currentJobId;
-std::atomic<uint64_t> totalHashes(0);
 
 // Mining statistics
 std::atomic<uint64_t> acceptedShares(0);
@@ -36,6 +35,7 @@ std::atomic<uint64_t> rejectedShares(0);
 std::atomic<uint64_t> jsonRpcId(0);
 std::string sessionId;
 std::vector<MiningThreadData*> threadData;
+std::mutex threadDataMutex;
 
 // RandomX globals
 randomx_cache* currentCache = nullptr;
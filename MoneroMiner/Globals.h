@@ -36,13 +36,13 @@ extern std::queue<Job> jobQueue;
 extern std::string currentBlobHex;
 extern std::string currentTargetHex;
 extern std::string currentJobId;
-extern std::atomic<uint64_t> totalHashes;
 
 // Global variables declarations
 extern std::atomic<uint64_t> acceptedShares;
 extern std::atomic<uint64_t> rejectedShares;
 extern std::string sessionId;
 extern std::vector<MiningThreadData*> threadData;
+extern std::mutex threadDataMutex;  // Held while threadData is filled or cleared, and by readers on other threads
 
 // RandomX globals
 extern randomx_cache* currentCache;
@@ -10,7 +10,7 @@
 extern Config config;
 
 // Default constructor
-Job::Job() : jobId(""), height(0), seedHash(""), difficulty(0), nonceOffset(39), blob() {
+Job::Job() : jobId(""), height(0), seedHash(""), difficulty(0), nonceOffset(39) {
     targetHash = {0, 0, 0, 0};
 }
 
@@ -20,9 +20,15 @@ Job::Job(const Job& other)
     , seedHash(other.seedHash)
     , difficulty(other.difficulty)
     , nonceOffset(other.nonceOffset)
+    , generation(other.generation)
+    , datasetGeneration(other.datasetGeneration)
+    , pool(other.pool)
+    , receivedAt(other.receivedAt)
+    , nonces(other.nonces)
     , targetHash(other.targetHash)
-    , blob(other.blob)
+    , blobSize(other.blobSize)
 {
+    std::memcpy(blob, other.blob, blobSize);
 }
 
 // Copy assignment
@@ -33,24 +39,32 @@ Job& Job::operator=(const Job& other) {
         seedHash = other.seedHash;
         difficulty = other.difficulty;
         nonceOffset = other.nonceOffset;
+        generation = other.generation;
+        datasetGeneration = other.datasetGeneration;
+        pool = other.pool;
+        receivedAt = other.receivedAt;
+        nonces = other.nonces;
         targetHash = other.targetHash;
-        blob = other.blob;
+        blobSize = other.blobSize;
+        std::memcpy(blob, other.blob, blobSize);
         
         // Remove debug spam - assignment operator is called frequently
     }
     return *this;
 }
 
-Job::Job(const std::string& blobHex, const std::string& id, const std::string& targetHex,
-         uint64_t h, const std::string& seed)
+Job::Job(std::string_view blobHex, std::string_view id, std::string_view targetHex,
+         uint64_t h, std::string_view seed)
     : jobId(id), height(h), seedHash(seed), difficulty(0), nonceOffset(0)
+    , receivedAt(std::chrono::steady_clock::now())
 {
-    blob = Utils::hexToBytes(blobHex);
+    blobSize = Utils::hexToBytes(blobHex, blob, sizeof(blob));
     nonceOffset = findNonceOffset();
     
-    std::vector<uint8_t> targetData = Utils::hexToBytes(targetHex);
+    uint8_t targetData[32];
+    size_t targetSize = Utils::hexToBytes(targetHex, targetData, sizeof(targetData));
     
-    if (targetData.size() == 4) {
+    if (targetSize == 4) {
         // Parse 4-byte compact target as little-endian uint32
         uint32_t compactTarget = 0;
         for (size_t i = 0; i < 4; i++) {
@@ -81,7 +95,21 @@ Job::Job(const std::string& blobHex, const std::string& id, const std::string& t
             Utils::threadSafePrint(ss.str(), true);
         }
         
-    } else if (targetData.size() == 32) {
+    } else if (targetSize == 8) {
+        // 64-bit target, sent by pools once the difficulty exceeds what the
+        // compact form can express: the threshold for the top hash word
+        uint64_t target64 = 0;
+        for (size_t i = 0; i < 8; i++) {
+            target64 |= static_cast<uint64_t>(targetData[i]) << (i * 8);
+        }
+        
+        if (target64 == 0) target64 = 1;
+        
+        difficulty = 0xFFFFFFFFFFFFFFFFULL / target64;
+        uint256_t target256 = uint256_t::maximum() / difficulty;
+        targetHash = target256.data;
+        
+    } else if (targetSize == 32) {
         // Pool sent full 256-bit target (rare, but handle it)
         // Parse as little-endian 256-bit value
         for (int i = 0; i < 4; i++) {
@@ -142,12 +170,16 @@ bool Job::isValidShare(const std::array<uint64_t, 4>& hashResult) const {
      * This matches how xmrig/xmr-stak perform validation.
      */
     
+    return fullCompare(hashResult, targetHash);
+}
+
+bool Job::fullCompare(const std::array<uint64_t, 4>& hashResult, const std::array<uint64_t, 4>& target) {
     // Compare from most significant to least significant
     for (int i = 3; i >= 0; i--) {
-        if (hashResult[i] < targetHash[i]) {
+        if (hashResult[i] < target[i]) {
             return true;  // Hash is definitely less than target
         }
-        if (hashResult[i] > targetHash[i]) {
+        if (hashResult[i] > target[i]) {
             return false; // Hash is definitely greater than target
         }
         // If equal, continue to next word
@@ -177,9 +209,17 @@ size_t Job::findNonceOffset() const {
 }
 
 std::vector<uint8_t> Job::getBlobBytes() const {
+    return std::vector<uint8_t>(blob, blob + blobSize);
+}
+
+const uint8_t* Job::getBlobData() const {
     return blob;
 }
 
+size_t Job::getBlobSize() const {
+    return blobSize;
+}
+
 std::string Job::getJobId() const {
     return jobId;
 }
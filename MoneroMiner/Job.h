@@ -1,9 +1,14 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <cstdint>
 #include <array>
+#include <chrono>
+#include <memory>
+#include "NonceDispenser.h"
+#include "Constants.h"
 
 /*
  * Monero Mining Target Conversion
@@ -35,6 +40,11 @@ public:
     std::string seedHash;
     uint64_t difficulty;
     size_t nonceOffset;
+    uint64_t generation = 0;  // Set by PoolClient::distributeJob when published
+    uint64_t datasetGeneration = 0;  // RandomX cache/dataset pair the job is hashed with
+    size_t pool = 0;  // Config::getPools() index of the pool that sent it
+    std::chrono::steady_clock::time_point receivedAt;  // When parsed from the pool message
+    std::shared_ptr<NonceDispenser> nonces;  // Shared by all threads on this snapshot
     
     // 256-bit target stored as 4x uint64_t (little-endian)
     std::array<uint64_t, 4> targetHash;
@@ -42,9 +52,10 @@ public:
     // Default constructor (implemented in .cpp)
     Job();
 
-    // Parameterized constructor (implemented in .cpp)
-    Job(const std::string& blobHex, const std::string& id, const std::string& targetHex,
-        uint64_t h, const std::string& seed);
+    // Parameterized constructor (implemented in .cpp). The hex blob is decoded
+    // straight into the aligned blob buffer; a malformed one leaves it empty.
+    Job(std::string_view blobHex, std::string_view id, std::string_view targetHex,
+        uint64_t h, std::string_view seed);
 
     // Copy constructor (implemented in .cpp)
     Job(const Job& other);
@@ -55,6 +66,8 @@ public:
     // Other methods
     size_t findNonceOffset() const;
     std::vector<uint8_t> getBlobBytes() const;
+    const uint8_t* getBlobData() const;  // No-copy view of the blob
+    size_t getBlobSize() const;
     std::string getJobId() const;
     std::string getTarget() const;
     
@@ -63,10 +76,38 @@ public:
     
     // Compare hash against target (returns true if hash <= target)
     bool isValidShare(const std::array<uint64_t, 4>& hashResult) const;
+    bool isValidShare(const uint8_t* hash) const { return meetsTarget(hash, targetHash); }
+    
+    // Standard share test on a raw 32-byte RandomX hash. Pool targets sit far
+    // below 2^256, so comparing hash bytes 24..31 (the most significant word)
+    // with target[3] rejects nearly every hash in one compare; only the rare
+    // candidate pays for the full 256-bit compare.
+    static bool meetsTarget(const uint8_t* hash, const std::array<uint64_t, 4>& target);
+    static bool fullCompare(const std::array<uint64_t, 4>& hashWords, const std::array<uint64_t, 4>& target);
+    static uint64_t hashWord(const uint8_t* hash, int wordIdx);
     
     // Get target as hex string for display
     std::string getTargetHex() const;
 
 private:
-    std::vector<uint8_t> blob;
-};
\ No newline at end of file
+    alignas(64) uint8_t blob[MiningConstants::MAX_BLOB_SIZE];
+    size_t blobSize = 0;
+};
+
+// Inline: called once per hash from the mining loop
+
+inline uint64_t Job::hashWord(const uint8_t* hash, int wordIdx) {
+    // Little-endian load; compiles to a single 64-bit read on x86
+    const uint8_t* p = hash + wordIdx * 8;
+    return static_cast<uint64_t>(p[0])       | static_cast<uint64_t>(p[1]) << 8  |
+           static_cast<uint64_t>(p[2]) << 16 | static_cast<uint64_t>(p[3]) << 24 |
+           static_cast<uint64_t>(p[4]) << 32 | static_cast<uint64_t>(p[5]) << 40 |
+           static_cast<uint64_t>(p[6]) << 48 | static_cast<uint64_t>(p[7]) << 56;
+}
+
+inline bool Job::meetsTarget(const uint8_t* hash, const std::array<uint64_t, 4>& target) {
+    if (hashWord(hash, 3) > target[3]) {
+        return false;  // Fast reject
+    }
+    return fullCompare({hashWord(hash, 0), hashWord(hash, 1), hashWord(hash, 2), hashWord(hash, 3)}, target);
+}
\ No newline at end of file
@@ -0,0 +1,54 @@
+#include "LineBuffer.h"
+#include <cstring>
+
+void LineBuffer::compact() {
+    if (readPos == writePos) {
+        readPos = scanPos = writePos = 0;  // Common case: every line consumed
+        return;
+    }
+    if (writePos < CAPACITY || readPos == 0) {
+        return;  // Still room at the end, or nothing to reclaim
+    }
+    size_t length = writePos - readPos;
+    std::memmove(data, data + readPos, length);
+    scanPos -= readPos;
+    writePos = length;
+    readPos = 0;
+}
+
+char* LineBuffer::writePtr() {
+    compact();
+    return data + writePos;
+}
+
+size_t LineBuffer::writable() {
+    compact();
+    return CAPACITY - writePos;
+}
+
+void LineBuffer::commit(size_t bytes) {
+    writePos += bytes;
+}
+
+bool LineBuffer::nextLine(std::string_view& line) {
+    while (scanPos < writePos) {
+        // memchr is the vectorized scan in every libc we build against
+        const char* newline = static_cast<const char*>(std::memchr(data + scanPos, '\n', writePos - scanPos));
+        if (newline == nullptr) {
+            scanPos = writePos;
+            return false;
+        }
+        size_t start = readPos;
+        size_t end = static_cast<size_t>(newline - data);
+        readPos = scanPos = end + 1;
+
+        if (end > start && data[end - 1] == '\r') {
+            end--;
+        }
+        if (end > start) {
+            line = std::string_view(data + start, end - start);
+            return true;
+        }
+    }
+    return false;
+}
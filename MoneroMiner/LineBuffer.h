@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+// Fixed-capacity receive buffer that splits the stratum stream into lines
+// in place. recv() writes straight into it, memchr scans only bytes not yet
+// scanned, and complete lines come out as views into the buffer - no copy
+// and no allocation per message. The unfinished tail line is the only data
+// ever moved, to the front when the buffer runs out of room.
+class LineBuffer {
+public:
+    static constexpr size_t CAPACITY = 64 * 1024;  // Longest line accepted
+
+    // Room for the next recv(); compacts first. Zero space means the pending
+    // line is longer than CAPACITY.
+    char* writePtr();
+    size_t writable();
+    void commit(size_t bytes);  // bytes were written at writePtr()
+
+    // Next complete line without its "\n" / "\r\n", empty lines skipped. The
+    // view is valid until the next writePtr()/writable()/clear().
+    bool nextLine(std::string_view& line);
+
+    size_t pending() const { return writePos - readPos; }
+    void clear() { readPos = scanPos = writePos = 0; }
+
+private:
+    void compact();
+
+    alignas(64) char data[CAPACITY];
+    size_t readPos = 0;   // Start of the first unconsumed line
+    size_t scanPos = 0;   // Bytes before this hold no newline past readPos
+    size_t writePos = 0;  // End of received data
+};
@@ -1,5 +1,6 @@
 #include "MiningStats.h"
 #include "Globals.h"
+#include "MiningThreadData.h"
 #include <thread>
 #include <chrono>
 
@@ -7,6 +8,26 @@ namespace MiningStatsUtil {
     // Global counters defined here
     std::atomic<uint64_t> acceptedShares{0};
     std::atomic<uint64_t> rejectedShares{0};
+    static std::atomic<double> poolLatencyMs{0.0};  // Single writer: the network thread
+    
+    void recordPoolLatency(double ms) {
+        double average = poolLatencyMs.load(std::memory_order_relaxed);
+        poolLatencyMs.store(average == 0.0 ? ms : average * 0.875 + ms * 0.125, std::memory_order_relaxed);
+    }
+    
+    double getPoolLatencyMs() {
+        return poolLatencyMs.load(std::memory_order_relaxed);
+    }
+    
+    uint64_t getTotalHashes() {
+        uint64_t total = 0;
+        for (MiningThreadData* data : threadData) {
+            if (data) {
+                total += data->getTotalHashCount();
+            }
+        }
+        return total;
+    }
     
     // Background stats monitoring thread
     void globalStatsMonitor() {
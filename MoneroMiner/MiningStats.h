@@ -8,6 +8,14 @@ namespace MiningStatsUtil {
     extern std::atomic<uint64_t> acceptedShares;
     extern std::atomic<uint64_t> rejectedShares;
     
+    // Round trip of answered pool requests, recorded by the network thread;
+    // the reported value is a moving average (0 until the first reply)
+    void recordPoolLatency(double ms);
+    double getPoolLatencyMs();
+    
+    // Sum of the per-thread hash counters (read lazily, never on the hash path)
+    uint64_t getTotalHashes();
+    
     // Stats monitoring thread (runs in background)
     void globalStatsMonitor();
 }
\ No newline at end of file
@@ -1,10 +1,13 @@
 #include "MiningThreadData.h"
+#include "Job.h"
 #include "RandomXManager.h"
 #include "Utils.h"
 #include "Config.h"
 #include "Globals.h"
 #include "Types.h"
+#include <algorithm>
 #include <array>
+#include <cstring>
 #include <sstream>
 #include <iomanip>
 
@@ -12,7 +15,8 @@ MiningThreadData::MiningThreadData(int id) : threadId(id) {
 }
 
 MiningThreadData::~MiningThreadData() {
-    RandomXManager::cleanupVM(threadId);
+    // The thread's own VM lives as long as the thread data, across seed changes
+    if (vm) randomx_destroy_vm(vm);
 }
 
 bool MiningThreadData::initializeVM() {
@@ -20,74 +24,180 @@ bool MiningThreadData::initializeVM() {
         return true; // Already initialized
     }
 
-    // Get the global dataset/cache from RandomXManager
-    randomx_dataset* dataset = RandomXManager::getDataset();
-    randomx_cache* cache = RandomXManager::getCache();
+    // One consistent view of the active cache/dataset pair and its flags
+    RandomXManager::VMBinding binding = RandomXManager::getVMBinding(numaNode);
     
-    if (!dataset && !cache) {
+    if (!binding.dataset && !binding.cache) {
         return false; // Neither dataset nor cache available
     }
-
-    // Get flags from RandomXManager
-    randomx_flags flags = RandomXManager::getVMFlags();
     
     // Create VM with dataset (preferred) or cache
-    if (dataset) {
-        vm = randomx_create_vm(flags, cache, dataset);
-    } else {
-        vm = randomx_create_vm(flags, cache, nullptr);
-    }
+    vm = randomx_create_vm(binding.flags, binding.cache, binding.dataset);
+    vmUsesDataset = binding.dataset != nullptr;
+    boundDatasetGeneration = binding.generation;
     
     return vm != nullptr;
 }
 
-bool MiningThreadData::calculateHash(const std::vector<uint8_t>& input, uint64_t nonce) {
-    bool result = RandomXManager::calculateHashForThread(threadId, input, nonce);
-    incrementHashCount();
-    return result;
+void MiningThreadData::bindDataset(uint64_t datasetGeneration) {
+    if (!vm || datasetGeneration == boundDatasetGeneration ||
+        datasetGeneration != RandomXManager::getDatasetGeneration()) {
+        return;
+    }
+
+    // The unlocked check above only skips the common case; the pair is bound
+    // from a snapshot that must still be the job's generation
+    RandomXManager::VMBinding binding = RandomXManager::getVMBinding(numaNode);
+    if (binding.generation != datasetGeneration) {
+        return;
+    }
+    if (vmUsesDataset != (binding.dataset != nullptr)) {
+        // Light <-> full switch (hybrid start): a different VM type, so rebuild it
+        randomx_destroy_vm(vm);
+        vm = nullptr;
+        if (!initializeVM()) {
+            Utils::threadSafePrint("[T" + std::to_string(threadId) + "] VM creation failed after mode switch", true);
+        } else if (config.debugMode) {
+            Utils::threadSafePrint("[T" + std::to_string(threadId) + "] VM recreated in " +
+                (vmUsesDataset ? "full" : "light") + " mode", true);
+        }
+        return;
+    }
+
+    if (vmUsesDataset) {
+        randomx_vm_set_dataset(vm, binding.dataset);
+    } else if (binding.cache) {
+        randomx_vm_set_cache(vm, binding.cache);
+    }
+    boundDatasetGeneration = datasetGeneration;
+
+    if (config.debugMode) {
+        Utils::threadSafePrint("[T" + std::to_string(threadId) + "] VM rebound to dataset generation " +
+            std::to_string(datasetGeneration), true);
+    }
 }
 
-bool MiningThreadData::calculateHashAndCheckTarget(
-    const std::vector<uint8_t>& blob,
-    const std::vector<uint8_t>& targetBytes,
-    std::vector<uint8_t>& hashOut)
-{
-    if (!vm || blob.empty()) {
+bool MiningThreadData::prepareJob(const Job& job) {
+    // Hashing blobs are at least 76 bytes (header + tree root + tx count)
+    size_t blobSize = job.getBlobSize();
+    if (blobSize < 76 || blobSize > sizeof(workBlob) || job.nonceOffset + 4 > blobSize) {
+        workBlobSize = 0;
         return false;
     }
 
-    try {
-        // Calculate RandomX hash
-        randomx_calculate_hash(vm, blob.data(), blob.size(), hashOut.data());
-        
-        totalHashes++;
-        
-        // Convert hash and target to uint256_t using the constructor
-        uint256_t hashValue(hashOut.data());
-        uint256_t targetValue(targetBytes.data());
-        
-        // Use the built-in comparison operator
-        bool isValid = hashValue < targetValue;
-        
-        // Debug output - ONLY show every 10k hashes OR when valid share found
-        if (config.debugMode && (isValid || (totalHashes % 10000 == 0))) {
-            std::stringstream ss;
-            ss << "[T" << threadId << " PoW @ " << totalHashes << " hashes]\n";
-            ss << "  Hash:   " << hashValue.toHex() << "\n";
-            ss << "  Target: " << targetValue.toHex() << "\n";
-            ss << "  Result: " << (isValid ? "VALID SHARE FOUND!" : "does not meet target");
-            
-            if (isValid) {
-                ss << "\n  >>> SUBMITTING SHARE <<<";
-            }
-            
-            Utils::threadSafePrint(ss.str(), true);
-        }
-        
-        return isValid;
-        
+    std::memcpy(workBlob, job.getBlobData(), blobSize);
+    workBlobSize = blobSize;
+    nonceOffset = job.nonceOffset;
+
+    target = job.targetHash;
+    return true;
+}
+
+void MiningThreadData::setNonce(uint32_t nonce) {
+    /*
+     * Nonce Insertion into Mining Blob
+     * =================================
+     * 
+     * The nonce is a 4-byte (32-bit) little-endian value at byte 39-42:
+     * 
+     * Example nonce = 0x12345678:
+     *   byte[39] = 0x78  (least significant byte)
+     *   byte[40] = 0x56
+     *   byte[41] = 0x34
+     *   byte[42] = 0x12  (most significant byte)
+     * 
+     * This allows miners to search 2^32 (4.3 billion) nonce values
+     * per job before wrapping around or getting a new job.
+     */
+    workBlob[nonceOffset + 0] = static_cast<uint8_t>((nonce >>  0) & 0xFF);
+    workBlob[nonceOffset + 1] = static_cast<uint8_t>((nonce >>  8) & 0xFF);
+    workBlob[nonceOffset + 2] = static_cast<uint8_t>((nonce >> 16) & 0xFF);
+    workBlob[nonceOffset + 3] = static_cast<uint8_t>((nonce >> 24) & 0xFF);
+}
+
+bool MiningThreadData::calculateHashAndCheckTarget() {
+    if (!vm || workBlobSize == 0) {
+        return false;
     }
-    catch (...) {
+
+    // Calculate RandomX hash
+    randomx_calculate_hash(vm, workBlob, workBlobSize, hashResult);
+    return checkHashAgainstTarget();
+}
+
+void MiningThreadData::beginHashPipeline() {
+    if (!vm || workBlobSize == 0) {
+        return;
+    }
+
+    // Blake2b + scratchpad fill for the first input; the VM keeps the state,
+    // so the working blob may be overwritten right away
+    randomx_calculate_hash_first(vm, workBlob, workBlobSize);
+    pipelineActive = true;
+}
+
+bool MiningThreadData::calculateNextHashAndCheckTarget() {
+    if (!vm || !pipelineActive || workBlobSize == 0) {
+        return false;
+    }
+
+    // Runs the program for the pending input while the next input's
+    // scratchpad is filled - hashResult belongs to the PREVIOUS blob
+    randomx_calculate_hash_next(vm, workBlob, workBlobSize, hashResult);
+    return checkHashAgainstTarget();
+}
+
+bool MiningThreadData::finishHashPipeline() {
+    if (!vm || !pipelineActive) {
         return false;
     }
+
+    randomx_calculate_hash_last(vm, hashResult);
+    pipelineActive = false;
+    return checkHashAgainstTarget();
+}
+
+bool MiningThreadData::checkHashAgainstTarget() {
+    incrementHashCount();
+    return Job::meetsTarget(hashResult, target);
+}
+
+bool MiningThreadData::markShareSubmitted(uint64_t generation, uint32_t nonce) {
+    if (generation != submittedGeneration) {
+        submittedGeneration = generation;
+        submittedCount = 0;
+    }
+
+    size_t stored = (std::min)(submittedCount, SHARE_HISTORY);
+    for (size_t i = 0; i < stored; i++) {
+        if (submittedNonces[i] == nonce) {
+            return false;
+        }
+    }
+
+    submittedNonces[submittedCount % SHARE_HISTORY] = nonce;
+    submittedCount++;
+    return true;
+}
+
+void MiningThreadData::logHashCheck(bool isValid) const {
+    // Debug output - ONLY show every 10k hashes OR when valid share found
+    uint64_t hashes = getTotalHashCount();
+    if (!config.debugMode || !(isValid || (hashes % 10000 == 0))) {
+        return;
+    }
+
+    std::stringstream ss;
+    ss << "[T" << threadId << " PoW @ " << hashes << " hashes]\n";
+    ss << "  Hash:   " << uint256_t(hashResult).toHex() << "\n";
+    uint256_t targetValue;
+    targetValue.data = target;
+    ss << "  Target: " << targetValue.toHex() << "\n";
+    ss << "  Result: " << (isValid ? "VALID SHARE FOUND!" : "does not meet target");
+    
+    if (isValid) {
+        ss << "\n  >>> SUBMITTING SHARE <<<";
+    }
+    
+    Utils::threadSafePrint(ss.str(), true);
 }
\ No newline at end of file
@@ -1,9 +1,13 @@
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <cstdint>
 #include <vector>
 #include "randomx.h"
+#include "Constants.h"
+
+class Job;
 
 class MiningThreadData {
 public:
@@ -11,32 +15,103 @@ public:
     ~MiningThreadData();
 
     bool initializeVM();
-    bool calculateHash(const std::vector<uint8_t>& input, uint64_t nonce);
     
-    // CRITICAL: New method for proper hash calculation with target checking
-    bool calculateHashAndCheckTarget(
-        const std::vector<uint8_t>& blob,
-        const std::vector<uint8_t>& target,
-        std::vector<uint8_t>& hashOut
-    );
+    // Per-job working state: copies the job's blob and target into this
+    // thread's fixed buffers once, so the hash loop itself never allocates.
+    // Returns false if the blob does not fit or has no room for the nonce.
+    bool prepareJob(const Job& job);
+    void setNonce(uint32_t nonce);  // 4 little-endian bytes at the nonce offset
+    const uint8_t* getBlob() const { return workBlob; }
+    size_t getBlobSize() const { return workBlobSize; }
+    const uint8_t* getHash() const { return hashResult; }
+    
+    // CRITICAL: Hashes the working blob into getHash() and checks the target
+    bool calculateHashAndCheckTarget();
+    
+    // Pipelined hashing: beginHashPipeline() feeds the working blob, each
+    // calculateNextHashAndCheckTarget() feeds the current working blob and
+    // leaves the hash of the PREVIOUS one in getHash(), finishHashPipeline()
+    // drains the last input. Both return whether that hash meets the target.
+    void beginHashPipeline();
+    bool calculateNextHashAndCheckTarget();
+    bool finishHashPipeline();
+    bool isHashPipelineActive() const { return pipelineActive; }
+    
+    // Debug trace of the last hash check (every 10k hashes or on a share)
+    void logHashCheck(bool isValid) const;
+    
+    // Duplicate-share filter over the last SHARE_HISTORY shares this thread
+    // queued for the current job generation. Records the nonce and returns
+    // false if it was already there; a new generation starts an empty ring.
+    bool markShareSubmitted(uint64_t generation, uint32_t nonce);
     
     int getThreadId() const { return threadId; }
-    void setHashrate(double rate) { hashrate.store(rate); }
-    double getHashrate() const { return hashrate.load(); }
-    void incrementHashCount() { hashCount.fetch_add(1); }
-    uint64_t getTotalHashCount() const { return hashCount.load(); }
+    
+    // Index into RandomXManager's NUMA nodes; picks the dataset replica
+    void setNumaNode(size_t node) { numaNode = node; }
+    size_t getNumaNode() const { return numaNode; }
+    
+    // Logical CPU the thread is pinned to, -1 when not pinned to one CPU
+    void setCpu(int cpuId) { cpu = cpuId; }
+    int getCpu() const { return cpu; }
+    
+    // Per-thread counters replace the old global totalHashes: only the owning
+    // thread writes them (plain load+store, no locked RMW) and the stats code
+    // sums them across threads when it reports
+    void setHashrate(double rate) { hashrate.store(rate, std::memory_order_relaxed); }
+    double getHashrate() const { return hashrate.load(std::memory_order_relaxed); }
+    void incrementHashCount() { hashCount.store(hashCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed); }
+    uint64_t getTotalHashCount() const { return hashCount.load(std::memory_order_relaxed); }
     void incrementAccepted() { acceptedShares.fetch_add(1); }
     void incrementRejected() { rejectedShares.fetch_add(1); }
     uint64_t getAcceptedShares() const { return acceptedShares.load(); }
     uint64_t getRejectedShares() const { return rejectedShares.load(); }
     void setVM(randomx_vm* vmPtr) { vm = vmPtr; }
     randomx_vm* getVM() const { return vm; }
+    
+    // Re-points the VM at the active cache/dataset after a seed change instead
+    // of recreating it. Only binds when the job's pair is still the active one;
+    // a job from before a swap keeps the old pair, which is freed only after
+    // every thread acknowledged a newer job generation.
+    void bindDataset(uint64_t datasetGeneration);
+    
+    // Generation of the job snapshot this thread currently works on. Written by
+    // the mining thread, read by PoolClient to know when a snapshot is retired.
+    void setJobGeneration(uint64_t gen) { jobGeneration.store(gen, std::memory_order_release); }
+    uint64_t getJobGeneration() const { return jobGeneration.load(std::memory_order_acquire); }
+    
+    // Time from the pool message of the current job to this thread's first hash on it
+    void setJobStartLatency(uint64_t micros) { jobStartLatencyUs.store(micros, std::memory_order_relaxed); }
+    uint64_t getJobStartLatency() const { return jobStartLatencyUs.load(std::memory_order_relaxed); }
 
 private:
     int threadId;
+    size_t numaNode = 0;
+    int cpu = -1;
+    alignas(64) std::atomic<uint64_t> hashCount{0};  // Own cache line, written every hash
     std::atomic<double> hashrate{0.0};
-    std::atomic<uint64_t> hashCount{0};
     std::atomic<uint64_t> acceptedShares{0};
     std::atomic<uint64_t> rejectedShares{0};
     randomx_vm* vm = nullptr;
+    bool vmUsesDataset = false;  // Full-memory VM; light VMs rebind the cache only
+    uint64_t boundDatasetGeneration = 0;
+    bool pipelineActive = false;
+    alignas(64) std::atomic<uint64_t> jobGeneration{0};
+    std::atomic<uint64_t> jobStartLatencyUs{0};
+
+    // Hot working set, touched only by the owning thread
+    alignas(64) uint8_t workBlob[MiningConstants::MAX_BLOB_SIZE] = {};
+    alignas(64) uint8_t hashResult[MiningConstants::HASH_SIZE] = {};
+    std::array<uint64_t, 4> target{};
+    size_t workBlobSize = 0;
+    size_t nonceOffset = 0;
+
+    // Ring of the nonces queued for submittedGeneration. Shares of older
+    // generations are discarded before they get here, so they are not kept.
+    static constexpr size_t SHARE_HISTORY = 16;
+    uint64_t submittedGeneration = 0;
+    uint32_t submittedNonces[SHARE_HISTORY] = {};
+    size_t submittedCount = 0;  // Since the generation changed; next slot is count % SHARE_HISTORY
+
+    bool checkHashAgainstTarget();
 };
\ No newline at end of file
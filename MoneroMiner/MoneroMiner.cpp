@@ -16,6 +16,9 @@
 #include "Job.h"
 #include "Globals.h"
 #include "Platform.h" // use Platform abstraction instead of direct windows.h
+#include "AllocationCounter.h"
+#include "ThreadPlacement.h"
+#include "Benchmark.h"
 #include <iostream>
 #include <thread>
 #include <vector>
@@ -26,8 +29,8 @@
 #include <iomanip>
 #include <sstream>
 #include <fstream>
-#include <unordered_set>
 #include <array> // Add for 256-bit target
+#include <algorithm>
 
 // Windows-only headers (keep only on Windows)
 #ifdef PLATFORM_WINDOWS
@@ -44,11 +47,24 @@ extern std::atomic<uint64_t> rejectedShares;
 extern std::atomic<uint64_t> jsonRpcId;
 extern std::string sessionId;
 extern std::vector<MiningThreadData*> threadData;
+extern std::mutex threadDataMutex;
 
 // Global variables
 std::vector<std::thread> miningThreads;
 std::thread jobListenerThread;
 
+// Startup barrier: every mining thread creates its VM after pinning itself,
+// so the scratchpad is first-touched on its own core and node, then waits
+// here until startMining() has seen all of them
+namespace {
+    std::mutex vmStartupMutex;
+    std::condition_variable vmStartupCV;
+    size_t vmsReady = 0;
+    size_t vmsFailed = 0;
+    bool vmStartupReleased = false;
+    bool vmStartupAborted = false;
+}
+
 // Forward declarations
 void printHelp();
 bool validateConfig();
@@ -258,10 +274,36 @@ void printHelp() {
               << "  --logfile            Enable logging to file\n"
               << "  --threads N          Number of mining threads (default: 1)\n"
               << "  --pool ADDRESS:PORT  Pool address and port (default: xmr-eu1.nanopool.org:14444)\n"
+              << "  --backup-pool ADDRESS:PORT\n"
+              << "                       Failover pool; repeat for more. A logged-in standby\n"
+              << "                       is kept and the fastest healthy pool is preferred\n"
               << "  --wallet ADDRESS     Your Monero wallet address\n"
               << "  --worker NAME        Worker name (default: worker1)\n"
               << "  --password X         Pool password (default: x)\n"
-              << "  --useragent AGENT    User agent string (default: MoneroMiner/1.0.0)\n\n"
+              << "  --useragent AGENT    User agent string (default: MoneroMiner/1.0.0)\n"
+              << "  --no-pipeline        Disable pipelined hashing (default: enabled)\n"
+              << "  --nicehash           Keep the pool's top nonce byte (default: disabled)\n"
+              << "  --dataset-double-buffer MIB\n"
+              << "                       Build the next seed's dataset in the background;\n"
+              << "                       needs 2336 MiB for the second cache+dataset (default: 0, off)\n"
+              << "  --no-numa            One shared dataset instead of a replica per NUMA node\n"
+              << "  --affinity MODE      auto: pin by L3/core topology, none: no pinning (default: auto)\n"
+              << "  --cpu-list LIST      Pin thread N to the Nth CPU of LIST, e.g. 0,2,4-7\n"
+              << "  --randomx-mode MODE  auto, full or light; auto picks full when available\n"
+              << "                       memory and the cgroup limit allow (default: auto)\n"
+              << "  --no-hybrid-start    Wait for the dataset instead of hashing in light mode\n"
+              << "                       while it is built (default: hybrid start)\n"
+              << "  --init-threads N     Dataset initialization threads (default: all CPUs but one)\n"
+              << "  --dataset-dir DIR    Where dataset files are saved; only the current and next\n"
+              << "                       seed's files are kept (default: working directory)\n"
+              << "  --no-dataset-files   Never load or save dataset files; every seed's dataset\n"
+              << "                       is built in memory (default: files enabled)\n"
+              << "  --benchmark          Time dataset init and hashing offline, without a pool\n"
+              << "  --benchmark-seconds N\n"
+              << "                       Hashing time of --benchmark (default: 20)\n"
+              << "  --benchmark-stratum [FILE]\n"
+              << "                       Replay recorded pool traffic (FILE, or a built-in\n"
+              << "                       sample) through the receive path and time it\n\n"
               << "Example:\n"
               << "  MoneroMiner --debug --logfile --threads 4 --wallet YOUR_WALLET_ADDRESS\n"
               << std::endl;
@@ -290,6 +332,9 @@ void signalHandler(int signum) {
 void printConfig() {
     std::cout << "Current Configuration:" << std::endl;
     std::cout << "Pool Address: " << config.poolAddress << ":" << config.poolPort << std::endl;
+    for (const PoolEndpoint& backup : config.backupPools) {
+        std::cout << "Backup Pool: " << backup.host << ":" << backup.port << std::endl;
+    }
     std::cout << "Wallet: " << config.walletAddress << std::endl;
     std::cout << "Worker Name: " << config.workerName << std::endl;
     std::cout << "User Agent: " << config.userAgent << std::endl;
@@ -299,85 +344,99 @@ void printConfig() {
     std::cout << std::endl;
 }
 
-static std::mutex foundNonceMutex;
-static std::unordered_set<uint32_t> submittedNonces;
-static std::string currentMiningJobId;
-
 void miningThread(MiningThreadData* data) {
     try {
-        if (!data || !data->initializeVM()) {
-            Utils::threadSafePrint("Thread " + std::to_string(data->getThreadId()) + " init failed", true);
+        // Pinned to the planned CPU, or at least to the node whose dataset
+        // replica the VM reads
+        if (data && data->getCpu() >= 0) {
+            Platform::pinCurrentThread({static_cast<unsigned int>(data->getCpu())});
+        } else if (data && RandomXManager::getNumaNodeCount() > 1) {
+            if (const Platform::NumaNode* node = RandomXManager::getNumaNode(data->getNumaNode())) {
+                Platform::pinCurrentThread(node->cpus);
+            }
+        }
+
+        bool vmReady = data && data->initializeVM();
+        {
+            std::unique_lock<std::mutex> lock(vmStartupMutex);
+            ++(vmReady ? vmsReady : vmsFailed);
+            vmStartupCV.notify_all();
+            vmStartupCV.wait(lock, [] { return vmStartupReleased || shouldStop; });
+            vmReady = vmReady && !vmStartupAborted;
+        }
+        if (!vmReady) {
+            if (data) {
+                Utils::threadSafePrint("Thread " + std::to_string(data->getThreadId()) + " init failed", true);
+                data->setJobGeneration(UINT64_MAX);  // Never blocks a job switch
+            }
             return;
         }
 
-        // CRITICAL FIX: Calculate UNIQUE nonce range for this thread
-        uint32_t totalThreads = static_cast<uint32_t>(config.numThreads);
-        uint64_t totalNonceSpace = 0x100000000ULL;
-        uint64_t nonceRangePerThread = totalNonceSpace / totalThreads;
-        
-        uint32_t startNonce = static_cast<uint32_t>(data->getThreadId() * nonceRangePerThread);
-        uint32_t endNonce = (data->getThreadId() == static_cast<int>(totalThreads) - 1) 
-            ? 0xFFFFFFFF 
-            : static_cast<uint32_t>((data->getThreadId() + 1) * nonceRangePerThread - 1);
-        
-        uint32_t localNonce = startNonce;
-        std::string lastJobId;
+        // Nonces come in chunks from the job's shared dispenser: [localNonce, chunkEnd)
+        uint64_t localNonce = 0;
+        uint64_t chunkEnd = 0;
+        std::shared_ptr<const Job> job;  // Immutable snapshot, reloaded only on a new generation
+        uint64_t jobGeneration = 0;
         auto lastHashrateUpdate = std::chrono::steady_clock::now();
         uint64_t hashesInPeriod = 0;
         uint64_t hashesTotal = 0;
-        std::vector<uint8_t> workingBlob;
-        workingBlob.reserve(128);
-        std::vector<uint8_t> hashResult(32);
         uint64_t debugHashCounter = 0;
+        uint32_t pendingNonce = 0;  // Nonce of the input in flight when pipelined
+        bool firstHashPending = false;  // Job start latency not yet recorded
+#ifdef MONEROMINER_COUNT_ALLOCATIONS
+        uint64_t periodAllocations = 0;  // Heap allocations inside the hash step
+        bool allocationWarned = false;
+        bool vmWarmedUp = false;  // First hash on a fresh VM allocates once inside RandomX
+#endif
 
         if (config.debugMode) {
-            std::string msg = "[T" + std::to_string(data->getThreadId()) + "] Started | Nonce range: 0x" + Utils::formatHex(localNonce, 8) + " - 0x" + Utils::formatHex(endNonce, 8) + "\n";
-            Utils::threadSafePrint(msg, true);
-        }
-
-        if (config.debugMode) {
-            std::stringstream ss;
-            ss << "[T" << data->getThreadId() << "] Unique nonce range: 0x" 
-               << std::hex << std::setw(8) << std::setfill('0') << startNonce 
-               << " - 0x" << endNonce;
-            Utils::threadSafePrint(ss.str(), true);
+            Utils::threadSafePrint("[T" + std::to_string(data->getThreadId()) + "] Started | Nonces: " +
+                std::to_string(NonceDispenser::CHUNK_SIZE) + " per chunk from the shared dispenser", true);
         }
 
         while (!shouldStop) {
             try {
-                Job jobCopy;
-                std::string currentJobId;
-                
-                {
-                    std::lock_guard<std::mutex> lock(PoolClient::jobMutex);
-                    if (PoolClient::jobQueue.empty()) {
-                        std::this_thread::sleep_for(std::chrono::milliseconds(100));
-                        continue;
+                // One atomic load per hash; the snapshot pointer itself is
+                // only touched when the publisher bumped the generation
+                uint64_t publishedGeneration = PoolClient::jobGeneration.load(std::memory_order_acquire);
+                if (publishedGeneration != jobGeneration) {
+                    if (data->isHashPipelineActive()) {
+                        // Drain the input still in flight - its hash belongs to the
+                        // previous job, so it is counted but never submitted
+                        data->finishHashPipeline();
                     }
-                    
-                    jobCopy = PoolClient::jobQueue.front();
-                    currentJobId = jobCopy.getJobId();
-                    
-                    // Clear submitted nonces when job changes
-                    if (currentMiningJobId != currentJobId) {
-                        std::lock_guard<std::mutex> nonceLock(foundNonceMutex);
-                        submittedNonces.clear();
-                        currentMiningJobId = currentJobId;
+
+                    job = PoolClient::getCurrentJob();
+                    jobGeneration = job ? job->generation : publishedGeneration;
+                    if (job) {
+                        // Before the acknowledgement below: after a seed change the
+                        // publisher frees the old dataset once every thread has acked
+                        data->bindDataset(job->datasetGeneration);
                     }
-                }
-                
-                if (currentJobId != lastJobId) {
+                    data->setJobGeneration(jobGeneration);  // Previous snapshot released
+                    if (!job) {
+                        continue;  // Parked (e.g. dataset rebuild) - wait below
+                    }
+
+                    // Blob and target are copied into the thread's fixed buffers
+                    // once per job; the hash loop below only rewrites the nonce
+                    if (!data->prepareJob(*job)) {
+                        Utils::threadSafePrint("[T" + std::to_string(data->getThreadId()) + "] Invalid blob for job " + job->jobId + " - waiting for next job", true);
+                        job.reset();
+                        continue;
+                    }
+
                     if (config.debugMode) {
                         std::stringstream ss;
-                        ss << "[T" << data->getThreadId() << "] [JOB] " << currentJobId 
-                           << " | H:" << jobCopy.height << " | D:" << jobCopy.difficulty 
+                        ss << "[T" << data->getThreadId() << "] [JOB] " << job->jobId 
+                           << " | H:" << job->height << " | D:" << job->difficulty 
                            << " | Hashes:" << hashesTotal << "\n"
-                           << "Target: " << jobCopy.getTarget();
+                           << "Target: " << job->getTarget();
                         Utils::threadSafePrint(ss.str(), true);
                     }
                     
-                    lastJobId = currentJobId;
-                    localNonce = startNonce;
+                    localNonce = chunkEnd = 0;  // Old chunk belongs to the old job
+                    firstHashPending = true;
                     hashesInPeriod = 0;
                     hashesTotal = 0;
                     debugHashCounter = 0;
@@ -386,69 +445,75 @@ void miningThread(MiningThreadData* data) {
                     continue;
                 }
 
-                if (localNonce > endNonce) {
-                    // This thread exhausted its range, wait for new job
-                    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                if (!job) {
+                    PoolClient::waitForNewJob(jobGeneration);
                     continue;
                 }
 
-                workingBlob = jobCopy.getBlobBytes();
-                if (workingBlob.empty() || workingBlob.size() < 76) {
-                    if (config.debugMode) {
-                        Utils::threadSafePrint("[T" + std::to_string(data->getThreadId()) + "] FATAL: Blob too short", true);
+                // Chunk used up: take the next one. Threads that hash faster come
+                // back sooner and so cover more of the space
+                if (localNonce >= chunkEnd) {
+                    uint32_t first = 0;
+                    uint32_t count = 0;
+                    if (job->nonces && job->nonces->acquire(first, count)) {
+                        localNonce = first;
+                        chunkEnd = static_cast<uint64_t>(first) + count;
                     }
-                    std::this_thread::sleep_for(std::chrono::milliseconds(100));
-                    continue;
                 }
 
-                if (jobCopy.nonceOffset + 4 > workingBlob.size()) {
-                    if (config.debugMode) {
-                        Utils::threadSafePrint("[T" + std::to_string(data->getThreadId()) + "] FATAL: Invalid nonce offset", true);
-                    }
-                    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                // Job's nonce space exhausted: drain the pipeline once (its hash is
+                // still for the current job), then block until a new job is published
+                bool drainPipeline = localNonce >= chunkEnd;
+                if (drainPipeline && !data->isHashPipelineActive()) {
+                    PoolClient::waitForNewJob(jobGeneration);
                     continue;
                 }
 
-                // CRITICAL: Insert nonce as LITTLE-ENDIAN 32-bit value
-                /*
-                 * Nonce Insertion into Mining Blob
-                 * =================================
-                 * 
-                 * The nonce is a 4-byte (32-bit) little-endian value at byte 39-42:
-                 * 
-                 * Example nonce = 0x12345678:
-                 *   byte[39] = 0x78  (least significant byte)
-                 *   byte[40] = 0x56
-                 *   byte[41] = 0x34
-                 *   byte[42] = 0x12  (most significant byte)
-                 * 
-                 * This allows miners to search 2^32 (4.3 billion) nonce values
-                 * per job before wrapping around or getting a new job.
-                 */
-                uint32_t nonce32 = static_cast<uint32_t>(localNonce & 0xFFFFFFFFULL);
-                size_t offset = jobCopy.nonceOffset;
-                workingBlob[offset + 0] = static_cast<uint8_t>((nonce32 >>  0) & 0xFF);
-                workingBlob[offset + 1] = static_cast<uint8_t>((nonce32 >>  8) & 0xFF);
-                workingBlob[offset + 2] = static_cast<uint8_t>((nonce32 >> 16) & 0xFF);
-                workingBlob[offset + 3] = static_cast<uint8_t>((nonce32 >> 24) & 0xFF);
-
-                // Hash calculation
                 bool hashOk = false;
-                {
-                    // Defensive: zero hashResult before calculation
-                    std::fill(hashResult.begin(), hashResult.end(), 0);
-                    
-                    // Convert targetHash (4x uint64_t) to bytes (32 bytes) for calculation
-                    std::vector<uint8_t> targetBytes(32, 0);
-                    for (int wordIdx = 0; wordIdx < 4; wordIdx++) {
-                        uint64_t word = jobCopy.targetHash[wordIdx];
-                        for (int byteIdx = 0; byteIdx < 8; byteIdx++) {
-                            targetBytes[wordIdx * 8 + byteIdx] = static_cast<uint8_t>((word >> (byteIdx * 8)) & 0xFF);
-                        }
+                uint32_t resultNonce = 0;  // Nonce the hash in getHash() belongs to
+#ifdef MONEROMINER_COUNT_ALLOCATIONS
+                const uint64_t allocationsBefore = AllocationCounter::threadAllocations();
+#endif
+
+                if (drainPipeline) {
+                    hashOk = data->finishHashPipeline();
+                    resultNonce = pendingNonce;
+                } else {
+                    if (firstHashPending) {
+                        // Includes wakeup, snapshot load and any dataset rebuild
+                        firstHashPending = false;
+                        data->setJobStartLatency(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                            std::chrono::steady_clock::now() - job->receivedAt).count()));
                     }
-                    
-                    hashOk = data->calculateHashAndCheckTarget(workingBlob, targetBytes, hashResult);
+
+                    uint32_t nonce32 = static_cast<uint32_t>(localNonce & 0xFFFFFFFFULL);
+                    data->setNonce(nonce32);
+
+                    if (!config.pipelineHashing) {
+                        hashOk = data->calculateHashAndCheckTarget();
+                        resultNonce = nonce32;
+                    } else if (!data->isHashPipelineActive()) {
+                        // Prime the pipeline - no result until the next nonce is fed in
+                        data->beginHashPipeline();
+                        pendingNonce = nonce32;
+                        localNonce++;
+                        continue;
+                    } else {
+                        // Result is for the previously fed nonce
+                        hashOk = data->calculateNextHashAndCheckTarget();
+                        resultNonce = pendingNonce;
+                        pendingNonce = nonce32;
+                    }
+                }
+
+#ifdef MONEROMINER_COUNT_ALLOCATIONS
+                if (vmWarmedUp) {
+                    periodAllocations += AllocationCounter::threadAllocations() - allocationsBefore;
                 }
+                vmWarmedUp = true;
+#endif
+                data->logHashCheck(hashOk);
+                const uint8_t* hashResult = data->getHash();
 
                 debugHashCounter++;
                 
@@ -456,7 +521,7 @@ void miningThread(MiningThreadData* data) {
                 if (config.debugMode && (debugHashCounter % 10000 == 0)) {
                     std::stringstream ss;
                     ss << "[T" << data->getThreadId() << "] Hash #" << debugHashCounter 
-                       << " | Nonce: 0x" << std::hex << std::setw(8) << std::setfill('0') << nonce32 << "\n";
+                       << " | Nonce: 0x" << std::hex << std::setw(8) << std::setfill('0') << resultNonce << "\n";
                     
                     ss << "  Hash (LE):   ";
                     for (size_t i = 0; i < 32; i++) {
@@ -467,7 +532,7 @@ void miningThread(MiningThreadData* data) {
                     ss << "\n  Target (LE): ";
                     // Convert targetHash to bytes for display
                     for (int wordIdx = 0; wordIdx < 4; wordIdx++) {
-                        uint64_t word = jobCopy.targetHash[wordIdx];
+                        uint64_t word = job->targetHash[wordIdx];
                         for (int byteIdx = 0; byteIdx < 8; byteIdx++) {
                             uint8_t byte = static_cast<uint8_t>((word >> (byteIdx * 8)) & 0xFF);
                             ss << std::hex << std::setw(2) << std::setfill('0') << (int)byte;
@@ -479,7 +544,7 @@ void miningThread(MiningThreadData* data) {
                     ss << "\n  Byte-by-byte comparison (LE order):";
                     bool hashStillValid = true;
                     for (size_t i = 0; i < 8; i++) {
-                        uint8_t targetByte = static_cast<uint8_t>((jobCopy.targetHash[0] >> (i * 8)) & 0xFF);
+                        uint8_t targetByte = static_cast<uint8_t>((job->targetHash[0] >> (i * 8)) & 0xFF);
                         ss << "\n    Byte[" << i << "]: Hash=0x" 
                            << std::hex << std::setw(2) << std::setfill('0') << (int)hashResult[i]
                            << " vs Target=0x" 
@@ -500,9 +565,9 @@ void miningThread(MiningThreadData* data) {
                     
                     ss << "\n  Result: " << (hashOk ? "VALID SHARE" : "Does not meet target");
                     ss << "\n  Expected shares so far: " << std::fixed << std::setprecision(3) 
-                       << (static_cast<double>(hashesTotal) / static_cast<double>(jobCopy.difficulty));
+                       << (static_cast<double>(hashesTotal) / static_cast<double>(job->difficulty));
                     
-                    bool isAllZeros = std::all_of(hashResult.begin(), hashResult.end(), [](uint8_t b){ return b == 0; });
+                    bool isAllZeros = std::all_of(hashResult, hashResult + 32, [](uint8_t b){ return b == 0; });
                     if (isAllZeros) {
                         ss << "\n  [WARNING: Hash is all zeros - VM calculation error!]";
                     }
@@ -511,78 +576,41 @@ void miningThread(MiningThreadData* data) {
                 }
 
                 // Check for valid share
-                bool isAllZeros = std::all_of(hashResult.begin(), hashResult.end(), [](uint8_t b){ return b == 0; });
+                bool isAllZeros = std::all_of(hashResult, hashResult + 32, [](uint8_t b){ return b == 0; });
                 if (hashOk && !isAllZeros) {
-                    // CRITICAL: Check for duplicate submission BEFORE doing anything
-                    bool shouldSubmit = false;
-                    {
-                        std::lock_guard<std::mutex> lock(foundNonceMutex);
-                        if (submittedNonces.find(nonce32) == submittedNonces.end()) {
-                            submittedNonces.insert(nonce32);
-                            shouldSubmit = true;
-                            
-                            // Limit memory
-                            if (submittedNonces.size() > 10000) {
-                                submittedNonces.clear();
-                                submittedNonces.insert(nonce32);
-                            }
+                    // Stale or duplicate shares are dropped here; nonces are never
+                    // shared between threads, so the filter is per thread
+                    if (PoolClient::jobGeneration.load(std::memory_order_acquire) != jobGeneration) {
+                        if (config.debugMode) {
+                            Utils::threadSafePrint("[T" + std::to_string(data->getThreadId()) + 
+                                                 "] Discarding stale share", true);
                         }
-                    }
-                    
-                    if (!shouldSubmit) {
-                        localNonce++;
-                        continue; // Skip - already submitted
-                    }
-                    
-                    // Double-check job still current
-                    {
-                        std::lock_guard<std::mutex> lock(PoolClient::jobMutex);
-                        if (PoolClient::jobQueue.empty() || 
-                            PoolClient::jobQueue.front().getJobId() != currentJobId) {
-                            if (config.debugMode) {
-                                Utils::threadSafePrint("[T" + std::to_string(data->getThreadId()) + 
-                                                     "] Discarding stale share", true);
-                            }
-                            localNonce++;
-                            continue;
+                    } else if (!data->markShareSubmitted(jobGeneration, resultNonce)) {
+                        if (config.debugMode) {
+                            Utils::threadSafePrint("[T" + std::to_string(data->getThreadId()) + 
+                                                 "] Duplicate share suppressed | Nonce: " + Utils::nonceToHex(resultNonce), true);
+                        }
+                    } else {
+                        if (config.debugMode) {
+                            Utils::threadSafePrint("[T" + std::to_string(data->getThreadId()) + "] Share at attempt " + std::to_string(hashesTotal) +
+                                                 " | Nonce: " + Utils::nonceToHex(resultNonce), true);
                         }
-                    }
-                    
-                    // CRITICAL FIX: Format nonce as 8-character hex (little-endian bytes)
-                    std::stringstream nonceStream;
-                    nonceStream << std::hex << std::setw(2) << std::setfill('0') << (int)workingBlob[offset + 0];
-                    nonceStream << std::hex << std::setw(2) << std::setfill('0') << (int)workingBlob[offset + 1];
-                    nonceStream << std::hex << std::setw(2) << std::setfill('0') << (int)workingBlob[offset + 2];
-                    nonceStream << std::hex << std::setw(2) << std::setfill('0') << (int)workingBlob[offset + 3];
-                    std::string nonceHex = nonceStream.str();
-                    
-                    // CRITICAL FIX: Send hash in LITTLE-ENDIAN byte order (as calculated by RandomX)
-                    std::stringstream hashStream;
-                    for (int i = 0; i < 32; i++) {
-                        hashStream << std::hex << std::setw(2) << std::setfill('0') << (int)hashResult[i];
-                    }
-                    std::string hashHex = hashStream.str();
 
-                    // Ultra-condensed single line format - REPLACED WITH TWO LINES
-                    Utils::threadSafePrint("Share found! J: " + currentJobId + " Nonce: " + nonceHex + " Attempts: " + std::to_string(hashesTotal), true);
-                    Utils::threadSafePrint("Hash: " + hashHex, true);
-                    
-                    if (config.debugMode) {
-                        Utils::threadSafePrint("  Blob with nonce (first 50 bytes): ", true);
-                        for (size_t i = 0; i < 50 && i < workingBlob.size(); i++) {
-                            std::cout << std::hex << std::setw(2) << std::setfill('0') << (int)workingBlob[i];
+                        // Hand the share to the network thread and keep hashing. Use
+                        // resultNonce, not the blob: when pipelined the blob already
+                        // holds the NEXT nonce. Accept/reject is counted when the
+                        // pool's reply comes back (PoolClient::processReply)
+                        if (!PoolClient::queueShare(jobGeneration, resultNonce, hashResult)) {
+                            Utils::threadSafePrint("[T" + std::to_string(data->getThreadId()) + "] Share queue full - share dropped", true);
                         }
-                        std::cout << std::dec << std::endl;
                     }
-
-                    // Submit share - PoolClient handles everything including response parsing
-                    PoolClient::submitShare(currentJobId, nonceHex, hashHex, "rx/0");
-                    // NOTE: Accept/reject counters are incremented by PoolClient::processShareResponse
                 }
 
                 hashesInPeriod++;
                 hashesTotal++;
-                localNonce++; // Move to next nonce in this thread's range
+                if (!drainPipeline) {
+                    localNonce++; // Move to next nonce in this thread's chunk
+                }
                 
                 auto now = std::chrono::steady_clock::now();
                 auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(now - lastHashrateUpdate).count();
@@ -594,9 +622,19 @@ void miningThread(MiningThreadData* data) {
                         Utils::threadSafePrint("[T" + std::to_string(data->getThreadId()) + "] Hashrate: " + 
                             std::to_string(static_cast<int>(hashrate)) + " H/s | Total: " + std::to_string(hashesTotal), true);
                     }
+#ifdef MONEROMINER_COUNT_ALLOCATIONS
+                    if (config.debugMode || (periodAllocations > 0 && !allocationWarned)) {
+                        Utils::threadSafePrint("[T" + std::to_string(data->getThreadId()) + "] Heap allocations in hash loop: " +
+                            std::to_string(periodAllocations) + " over " + std::to_string(hashesInPeriod) + " hashes", true);
+                        allocationWarned = allocationWarned || periodAllocations > 0;
+                    }
+#endif
                     
                     lastHashrateUpdate = now;
                     hashesInPeriod = 0;
+#ifdef MONEROMINER_COUNT_ALLOCATIONS
+                    periodAllocations = 0;
+#endif
                 }
                 
                 if ((localNonce & 0xFF) == 0) {
@@ -612,6 +650,7 @@ void miningThread(MiningThreadData* data) {
     catch (const std::exception& e) {
         Utils::threadSafePrint("Fatal thread error: " + std::string(e.what()), true);
     }
+    data->setJobGeneration(UINT64_MAX);
 }
 
 void processNewJob(const picojson::object& jobObj) {
@@ -650,13 +689,7 @@ void processNewJob(const picojson::object& jobObj) {
                 return;
             }
 
-            {
-                std::lock_guard<std::mutex> lock(PoolClient::jobMutex);
-                while (!PoolClient::jobQueue.empty()) {
-                    PoolClient::jobQueue.pop();
-                }
-                PoolClient::jobQueue.push(job);
-            }
+            PoolClient::distributeJob(job);
 
             if (!config.debugMode) {
                 Utils::threadSafePrint("New job: " + jobId + " | Height: " + std::to_string(height), false);
@@ -667,9 +700,6 @@ void processNewJob(const picojson::object& jobObj) {
                 Utils::threadSafePrint("  Target: 0x" + target, true);
                 Utils::threadSafePrint("  Difficulty: " + std::to_string(job.difficulty), true);
             }
-
-            PoolClient::jobAvailable.notify_all();
-            PoolClient::jobQueueCondition.notify_all();
         }
     }
     catch (const std::exception& e) {
@@ -719,6 +749,39 @@ bool loadConfig() {
                 if (obj.find("logFileName") != obj.end()) {
                     config.logFileName = obj.at("logFileName").get<std::string>();
                 }
+                if (obj.find("pipelineHashing") != obj.end()) {
+                    config.pipelineHashing = obj.at("pipelineHashing").get<bool>();
+                }
+                if (obj.find("nicehash") != obj.end()) {
+                    config.nicehash = obj.at("nicehash").get<bool>();
+                }
+                if (obj.find("affinity") != obj.end()) {
+                    config.affinity = obj.at("affinity").get<std::string>();
+                }
+                if (obj.find("cpuList") != obj.end()) {
+                    config.cpuList = obj.at("cpuList").get<std::string>();
+                }
+                if (obj.find("randomxMode") != obj.end()) {
+                    config.randomxMode = obj.at("randomxMode").get<std::string>();
+                }
+                if (obj.find("hybridStart") != obj.end()) {
+                    config.hybridStart = obj.at("hybridStart").get<bool>();
+                }
+                if (obj.find("initThreads") != obj.end()) {
+                    config.initThreads = static_cast<unsigned int>(obj.at("initThreads").get<double>());
+                }
+                if (obj.find("datasetDir") != obj.end()) {
+                    config.datasetDir = obj.at("datasetDir").get<std::string>();
+                }
+                if (obj.find("datasetFiles") != obj.end()) {
+                    config.datasetFiles = obj.at("datasetFiles").get<bool>();
+                }
+                if (obj.find("numaReplicas") != obj.end()) {
+                    config.numaReplicas = obj.at("numaReplicas").get<bool>();
+                }
+                if (obj.find("datasetDoubleBufferMiB") != obj.end()) {
+                    config.datasetDoubleBufferMiB = static_cast<uint64_t>(obj.at("datasetDoubleBufferMiB").get<double>());
+                }
                 
                 file.close();
                 return true;
@@ -755,7 +818,7 @@ bool startMining() {
     {
         std::unique_lock<std::mutex> lock(PoolClient::jobMutex);
         PoolClient::jobAvailable.wait_for(lock, std::chrono::seconds(10), 
-            [] { return !PoolClient::jobQueue.empty() || shouldStop; });
+            [] { return PoolClient::getCurrentJob() != nullptr || shouldStop; });
     }
 
     if (shouldStop) {
@@ -763,13 +826,7 @@ bool startMining() {
     }
     
     // Initialize RandomX before creating threads
-    Job* currentJob = nullptr;
-    {
-        std::lock_guard<std::mutex> lock(PoolClient::jobMutex);
-        if (!PoolClient::jobQueue.empty()) {
-            currentJob = &PoolClient::jobQueue.front();
-        }
-    }
+    std::shared_ptr<const Job> currentJob = PoolClient::getCurrentJob();
 
     if (!currentJob) {
         Utils::threadSafePrint("No job available for RandomX initialization", true);
@@ -781,23 +838,50 @@ bool startMining() {
         return false;
     }
 
-    // Initialize thread data
-    threadData.resize(static_cast<size_t>(config.numThreads));
-    for (size_t i = 0; i < static_cast<size_t>(config.numThreads); i++) {  // Fix: use size_t
-        threadData[i] = new MiningThreadData(static_cast<int>(i));
-        if (!threadData[i]->initializeVM()) {
-            Utils::threadSafePrint("Failed to initialize VM for thread " + std::to_string(i), true);
-            return false;
+    // One CPU per thread: --cpu-list as given, else planned from the topology
+    Platform::CpuTopology topology = Platform::getCpuTopology();
+    std::vector<unsigned int> threadCpus;
+    if (!config.cpuList.empty()) {
+        std::vector<unsigned int> cpus = Platform::parseCpuList(config.cpuList);
+        for (size_t i = 0; i < static_cast<size_t>(config.numThreads); i++) {
+            threadCpus.push_back(cpus[i % cpus.size()]);
         }
-        if (config.debugMode && i < 4) {
-            Utils::threadSafePrint("VM ready for thread " + std::to_string(i), true);
+    } else if (config.affinity == "auto") {
+        threadCpus = ThreadPlacement::plan(topology, static_cast<size_t>(config.numThreads));
+    }
+    Utils::threadSafePrint(threadCpus.empty() ? std::string("Thread placement: left to the OS")
+                                              : ThreadPlacement::describe(topology, threadCpus), true);
+
+    // Initialize thread data. The job listener is already running and walks
+    // threadData on a seed change, so the list is built aside and published
+    // complete, before any mining thread starts.
+    std::vector<MiningThreadData*> threads(static_cast<size_t>(config.numThreads));
+    for (size_t i = 0; i < threads.size(); i++) {  // Fix: use size_t
+        threads[i] = new MiningThreadData(static_cast<int>(i));
+        threads[i]->setNumaNode(i % RandomXManager::getNumaNodeCount());  // Spread evenly over nodes
+        if (i < threadCpus.size()) {
+            threads[i]->setCpu(static_cast<int>(threadCpus[i]));
+            // The replica to read is the one on the pinned CPU's node
+            for (size_t node = 0; node < RandomXManager::getNumaNodeCount(); node++) {
+                const Platform::NumaNode* numa = RandomXManager::getNumaNode(node);
+                if (numa && std::find(numa->cpus.begin(), numa->cpus.end(), threadCpus[i]) != numa->cpus.end()) {
+                    threads[i]->setNumaNode(node);
+                }
+            }
         }
     }
-    if (!config.debugMode) {
-        Utils::threadSafePrint("Initialized " + std::to_string(config.numThreads) + " mining threads", true);
+    {
+        std::lock_guard<std::mutex> lock(threadDataMutex);
+        threadData = threads;
     }
     
-    // Start mining threads
+    // Start mining threads; each creates its own VM once pinned
+    {
+        std::lock_guard<std::mutex> lock(vmStartupMutex);
+        vmsReady = vmsFailed = 0;
+        vmStartupReleased = vmStartupAborted = false;
+    }
+    auto vmStart = std::chrono::steady_clock::now();
     for (size_t i = 0; i < static_cast<size_t>(config.numThreads); i++) {  // Fix: use size_t
         miningThreads.emplace_back(miningThread, threadData[i]);
         if (config.debugMode) {
@@ -805,6 +889,26 @@ bool startMining() {
         }
     }
     
+    {
+        std::unique_lock<std::mutex> lock(vmStartupMutex);
+        vmStartupCV.wait(lock, [] {
+            return vmsReady + vmsFailed == static_cast<size_t>(config.numThreads) || shouldStop;
+        });
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - vmStart).count();
+        Utils::threadSafePrint("Created " + std::to_string(vmsReady) + " VMs in parallel in " + std::to_string(ms) + " ms", true);
+        vmStartupAborted = vmsFailed > 0;
+        vmStartupReleased = true;
+        vmStartupCV.notify_all();
+        if (vmStartupAborted) {
+            // The threads exit on their own; the restart path joins them
+            Utils::threadSafePrint("Failed to initialize VM for " + std::to_string(vmsFailed) + " thread(s)", true);
+            return false;
+        }
+    }
+    if (!config.debugMode) {
+        Utils::threadSafePrint("Initialized " + std::to_string(config.numThreads) + " mining threads", true);
+    }
+    
     if (!config.debugMode) {
         Utils::threadSafePrint("Mining started - Press Ctrl+C to stop", true);
     } else {
@@ -863,6 +967,18 @@ int main(int argc, char* argv[]) {
     
     // Show configuration AFTER system info
     printConfig();
+
+    if (config.benchmarkStratum) {
+        int rc = Benchmark::runStratum();
+        Platform::cleanupSockets();
+        return rc;
+    }
+
+    if (config.benchmark) {
+        int rc = Benchmark::run();
+        Platform::cleanupSockets();
+        return rc;
+    }
     
     // Main mining loop with auto-restart
     bool firstRun = true;
@@ -878,6 +994,8 @@ int main(int argc, char* argv[]) {
             
             // Cleanup previous session
             shouldStop = true;
+            PoolClient::wakeMiningThreads();
+            PoolClient::wakeNetworkThread();
             
             // Wait for threads to stop
             for (auto& thread : miningThreads) {
@@ -887,10 +1005,13 @@ int main(int argc, char* argv[]) {
             if (statsThread.joinable()) statsThread.join();
             
             // Clean up resources
-            for (auto* data : threadData) {
-                delete data;
+            {
+                std::lock_guard<std::mutex> lock(threadDataMutex);
+                for (auto* data : threadData) {
+                    delete data;
+                }
+                threadData.clear();
             }
-            threadData.clear();
             miningThreads.clear();
             
             RandomXManager::cleanup();
@@ -919,6 +1040,7 @@ int main(int argc, char* argv[]) {
         
         // Main loop - monitor for connection issues
         auto lastStatsTime = std::chrono::steady_clock::now();
+        uint64_t lastTotalHashes = MiningStatsUtil::getTotalHashes();
         int secondsCounter = 0;
         auto lastJobTime = std::chrono::steady_clock::now();
         
@@ -927,11 +1049,8 @@ int main(int argc, char* argv[]) {
             secondsCounter++;
             
             // Check if we've received any jobs recently
-            {
-                std::lock_guard<std::mutex> lock(PoolClient::jobMutex);
-                if (!PoolClient::jobQueue.empty()) {
-                    lastJobTime = std::chrono::steady_clock::now();
-                }
+            if (PoolClient::getCurrentJob()) {
+                lastJobTime = std::chrono::steady_clock::now();
             }
             
             auto now = std::chrono::steady_clock::now();
@@ -950,19 +1069,22 @@ int main(int argc, char* argv[]) {
                 auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(now - lastStatsTime).count();
                 
                 if (elapsed >= 10) {
-                    double totalHashrate = 0.0;
+                    // Hashrate from the per-thread counters, summed only here
+                    uint64_t totalHashCount = MiningStatsUtil::getTotalHashes();
+                    double elapsedSeconds = std::chrono::duration<double>(now - lastStatsTime).count();
+                    double totalHashrate = static_cast<double>(totalHashCount - lastTotalHashes) / elapsedSeconds;
+                    lastTotalHashes = totalHashCount;
+                    
+                    uint64_t jobStartLatency = 0;  // Slowest thread to start the last job
                     for (size_t i = 0; i < threadData.size(); i++) {
                         if (threadData[i] != nullptr) {
-                            totalHashrate += threadData[i]->getHashrate();
+                            jobStartLatency = std::max(jobStartLatency, threadData[i]->getJobStartLatency());
                         }
                     }
                     
                     uint64_t currentDiff = 0;
-                    {
-                        std::lock_guard<std::mutex> lock(PoolClient::jobMutex);
-                        if (!PoolClient::jobQueue.empty()) {
-                            currentDiff = PoolClient::jobQueue.front().difficulty;
-                        }
+                    if (std::shared_ptr<const Job> job = PoolClient::getCurrentJob()) {
+                        currentDiff = job->difficulty;
                     }
                     
                     std::stringstream ss;
@@ -970,6 +1092,20 @@ int main(int argc, char* argv[]) {
                     ss << " | Difficulty: " << currentDiff;
                     ss << " | Accepted: " << MiningStatsUtil::acceptedShares.load();
                     ss << " | Rejected: " << MiningStatsUtil::rejectedShares.load();
+                    ss << " | Job start: " << std::setprecision(2) << (jobStartLatency / 1000.0) << " ms";
+                    ss << " | Pool RTT: " << std::setprecision(1) << MiningStatsUtil::getPoolLatencyMs() << " ms";
+                    
+                    size_t nodeCount = RandomXManager::getNumaNodeCount();
+                    if (nodeCount > 1) {
+                        std::vector<double> nodeHashrate(nodeCount, 0.0);
+                        for (MiningThreadData* thread : threadData) {
+                            if (thread) nodeHashrate[thread->getNumaNode() % nodeCount] += thread->getHashrate();
+                        }
+                        ss << " | Nodes:" << std::setprecision(1);
+                        for (size_t node = 0; node < nodeCount; node++) {
+                            ss << " " << RandomXManager::getNumaNode(node)->id << "=" << nodeHashrate[node];
+                        }
+                    }
                     
                     Utils::threadSafePrint(ss.str(), false);
                     lastStatsTime = now;
@@ -993,6 +1129,8 @@ int main(int argc, char* argv[]) {
     Utils::threadSafePrint("Shutting down miner...", true);
     
     shouldStop = true;
+    PoolClient::wakeMiningThreads();
+    PoolClient::wakeNetworkThread();
     
     for (auto& thread : miningThreads) {
         if (thread.joinable()) thread.join();
@@ -1001,10 +1139,13 @@ int main(int argc, char* argv[]) {
     if (statsThread.joinable()) statsThread.join();
     
     // Clean up resources
-    for (auto* data : threadData) {
-        delete data;
+    {
+        std::lock_guard<std::mutex> lock(threadDataMutex);
+        for (auto* data : threadData) {
+            delete data;
+        }
+        threadData.clear();
     }
-    threadData.clear();
     miningThreads.clear();
     
     RandomXManager::cleanup();
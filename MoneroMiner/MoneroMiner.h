@@ -27,7 +27,6 @@ extern std::string currentJobId;
 extern int jsonRpcId;
 extern std::string sessionId;
 extern std::atomic<bool> shouldStop;
-extern std::atomic<uint64_t> totalHashes;
 extern std::atomic<uint64_t> acceptedShares;
 extern std::atomic<uint64_t> rejectedShares;
 extern SOCKET globalSocket;
@@ -0,0 +1,26 @@
+#include "NonceDispenser.h"
+
+NonceDispenser::NonceDispenser(uint32_t prefix, int reservedBits) {
+    if (reservedBits <= 0) {
+        base = 0;
+        spaceSize = 0x100000000ULL;
+    } else {
+        if (reservedBits > 24) {
+            reservedBits = 24;  // Always leave at least one chunk's worth
+        }
+        spaceSize = 1ULL << (32 - reservedBits);
+        base = static_cast<uint32_t>(prefix & ~static_cast<uint32_t>(spaceSize - 1));
+    }
+}
+
+bool NonceDispenser::acquire(uint32_t& first, uint32_t& count) {
+    // 64-bit cursor: fetch_add past the end never wraps back into used nonces
+    uint64_t offset = cursor.fetch_add(CHUNK_SIZE, std::memory_order_relaxed);
+    if (offset >= spaceSize) {
+        return false;
+    }
+
+    first = base + static_cast<uint32_t>(offset);
+    count = static_cast<uint32_t>(spaceSize - offset < CHUNK_SIZE ? spaceSize - offset : CHUNK_SIZE);
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// Hands out the 32-bit nonce space of one job in fixed chunks. Every
+// published job snapshot owns a fresh dispenser, so a thread that asks
+// the current job for work can never receive nonces of an older one.
+// Threads take chunks as fast as they hash, so faster threads simply
+// end up with more of the space and no thread idles while work is left.
+class NonceDispenser {
+public:
+    static constexpr uint32_t CHUNK_SIZE = 4096;
+
+    // reservedBits high bits of every nonce are fixed to those of prefix
+    // (NiceHash-style pools own the top byte); 0 hands out the full space
+    explicit NonceDispenser(uint32_t prefix = 0, int reservedBits = 0);
+
+    // Next chunk as [first, first + count); false once the space is used up
+    bool acquire(uint32_t& first, uint32_t& count);
+
+    uint64_t getSpaceSize() const { return spaceSize; }
+
+private:
+    // Only the cursor is written after construction - keep it on its own line
+    alignas(64) std::atomic<uint64_t> cursor{0};
+    alignas(64) uint32_t base = 0;
+    uint64_t spaceSize = 0;
+};
\ No newline at end of file
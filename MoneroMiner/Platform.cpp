@@ -7,14 +7,74 @@
 #include <fstream>
 #include <cstring>
 #include <thread>
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
 #ifndef PLATFORM_WINDOWS
     #include <sys/sysinfo.h>
     #include <sys/utsname.h>
+    #include <sys/resource.h>
+    #include <sys/syscall.h>
     #include <unistd.h>
+    #include <pthread.h>
+    #include <sched.h>
+    #include <filesystem>
 #endif
 
 namespace Platform {
 
+    // Topology fallback when the OS exposes no NUMA information
+    static std::vector<NumaNode> singleNumaNode() {
+        NumaNode node{0, {}};
+        for (unsigned int cpu = 0; cpu < getLogicalProcessors(); cpu++) {
+            node.cpus.push_back(cpu);
+        }
+        return {node};
+    }
+
+    // Highest CPU id a list may name: the affinity mask size on Linux,
+    // 64 processor groups of 64 CPUs on Windows
+#ifdef PLATFORM_WINDOWS
+    static const unsigned long MAX_CPU_ID = 64 * 64 - 1;
+#else
+    static const unsigned long MAX_CPU_ID = CPU_SETSIZE - 1;
+#endif
+
+    // Unsigned decimal without sign or leading space; false if there is none
+    // or it overflows. end is left on the first character after the digits.
+    static bool parseCpuId(const char* text, char** end, unsigned long& value) {
+        if (!isdigit(static_cast<unsigned char>(*text))) {
+            return false;
+        }
+        errno = 0;
+        value = std::strtoul(text, end, 10);
+        return errno != ERANGE;
+    }
+
+    std::vector<unsigned int> parseCpuList(const std::string& list) {
+        std::vector<unsigned int> cpus;
+        std::stringstream ss(list);
+        std::string range;
+        while (std::getline(ss, range, ',')) {
+            range.erase(0, range.find_first_not_of(" \t\r\n"));
+            range.erase(range.find_last_not_of(" \t\r\n") + 1);
+            if (range.empty()) continue;
+
+            // "N" or "N-M"; anything else invalidates the whole list
+            char* end = nullptr;
+            unsigned long first = 0;
+            if (!parseCpuId(range.c_str(), &end, first)) return {};
+            unsigned long last = first;
+            if (*end == '-' && !parseCpuId(end + 1, &end, last)) return {};
+            if (*end != '\0' || last < first || last > MAX_CPU_ID) return {};
+
+            for (unsigned long cpu = first; cpu <= last; cpu++) {
+                cpus.push_back(static_cast<unsigned int>(cpu));
+            }
+        }
+        return cpus;
+    }
+
 #ifdef PLATFORM_WINDOWS
     bool initializeSockets() {
         WSADATA wsaData;
@@ -31,6 +91,11 @@ namespace Platform {
         WSACleanup();
     }
     
+    bool setSocketNonBlocking(socket_t socket) {
+        u_long mode = 1;
+        return ioctlsocket(socket, FIONBIO, &mode) == 0;
+    }
+    
     std::string getCPUBrand() {
         int cpuInfo[4] = {0};
         char cpuBrand[0x40] = {0};
@@ -96,6 +161,13 @@ namespace Platform {
         usage = memInfo.dwMemoryLoad;
     }
     
+    uint64_t getAvailableMemoryBytes() {
+        MEMORYSTATUSEX memInfo;
+        memInfo.dwLength = sizeof(MEMORYSTATUSEX);
+        if (!GlobalMemoryStatusEx(&memInfo)) return 0;
+        return memInfo.ullAvailPhys;
+    }
+    
     std::string getMotherboardInfo() {
         HKEY hKey;
         if (RegOpenKeyExA(HKEY_LOCAL_MACHINE, 
@@ -193,6 +265,14 @@ namespace Platform {
         return 0;
     }
     
+    bool hasTransparentHugePages() {
+        return false;
+    }
+    
+    uint64_t getTransparentHugePagesBytes(const void*, size_t) {
+        return 0;
+    }
+    
     std::string getHugePagesStatus() {
         if (!isRunningElevated()) {
             return "unavailable (not elevated)";
@@ -239,6 +319,109 @@ namespace Platform {
         return "unavailable";
     }
 
+    void lowerCurrentThreadPriority() {
+        SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_LOWEST);
+    }
+
+    std::vector<NumaNode> getNumaNodes() {
+        std::vector<NumaNode> nodes;
+        ULONG highestNode = 0;
+        if (GetNumaHighestNodeNumber(&highestNode)) {
+            for (USHORT id = 0; id <= highestNode; id++) {
+                GROUP_AFFINITY affinity = {};
+                if (!GetNumaNodeProcessorMaskEx(id, &affinity) || affinity.Mask == 0) continue;
+                NumaNode node{static_cast<int>(id), {}};
+                for (unsigned int bit = 0; bit < 64; bit++) {
+                    if (affinity.Mask & (static_cast<KAFFINITY>(1) << bit)) {
+                        node.cpus.push_back(affinity.Group * 64u + bit);
+                    }
+                }
+                nodes.push_back(node);
+            }
+        }
+        return nodes.empty() ? singleNumaNode() : nodes;
+    }
+
+    bool pinCurrentThread(const std::vector<unsigned int>& cpus) {
+        // A thread lives in one processor group; use the group of the first CPU
+        if (cpus.empty()) return false;
+        GROUP_AFFINITY affinity = {};
+        affinity.Group = static_cast<WORD>(cpus.front() / 64);
+        for (unsigned int cpu : cpus) {
+            if (cpu / 64 == affinity.Group) {
+                affinity.Mask |= static_cast<KAFFINITY>(1) << (cpu % 64);
+            }
+        }
+        return SetThreadGroupAffinity(GetCurrentThread(), &affinity, nullptr) != 0;
+    }
+
+    bool setCurrentThreadMemoryNodes(const std::vector<int>&) {
+        return false;  // RandomX's VirtualAlloc takes no node; normal pages follow first touch
+    }
+
+    uint64_t getNumaNodeBytes(const void*, size_t, int) {
+        return 0;
+    }
+
+    CpuTopology getCpuTopology() {
+        CpuTopology topology;
+        DWORD length = 0;
+        GetLogicalProcessorInformationEx(RelationAll, nullptr, &length);
+        std::vector<uint8_t> buffer(length);
+        if (length == 0 || !GetLogicalProcessorInformationEx(RelationAll,
+                reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(buffer.data()), &length)) {
+            for (unsigned int cpu = 0; cpu < getLogicalProcessors(); cpu++) {
+                topology.cpus.push_back({cpu, 0, static_cast<int>(cpu), 0, -1});
+            }
+            return topology;
+        }
+
+        // Relations come in no fixed order: collect, then link by CPU number
+        std::vector<std::pair<unsigned int, int>> packageOf;
+        int coreIndex = 0;
+        int packageIndex = 0;
+        auto forEachCpu = [](const GROUP_AFFINITY& mask, auto&& visit) {
+            for (unsigned int bit = 0; bit < 64; bit++) {
+                if (mask.Mask & (static_cast<KAFFINITY>(1) << bit)) visit(mask.Group * 64u + bit);
+            }
+        };
+        for (DWORD offset = 0; offset < length;) {
+            auto* info = reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(buffer.data() + offset);
+            if (info->Relationship == RelationProcessorCore) {
+                int smtIndex = 0;
+                forEachCpu(info->Processor.GroupMask[0], [&](unsigned int cpu) {
+                    topology.cpus.push_back({cpu, 0, coreIndex, smtIndex++, -1});
+                });
+                coreIndex++;
+            } else if (info->Relationship == RelationProcessorPackage) {
+                for (WORD group = 0; group < info->Processor.GroupCount; group++) {
+                    forEachCpu(info->Processor.GroupMask[group], [&](unsigned int cpu) {
+                        packageOf.emplace_back(cpu, packageIndex);
+                    });
+                }
+                packageIndex++;
+            } else if (info->Relationship == RelationCache && info->Cache.Level == 3) {
+                CacheDomain domain{info->Cache.CacheSize, {}};
+                forEachCpu(info->Cache.GroupMask, [&](unsigned int cpu) { domain.cpus.push_back(cpu); });
+                topology.l3Domains.push_back(domain);
+            }
+            offset += info->Size;
+        }
+
+        for (LogicalCpu& cpu : topology.cpus) {
+            for (const auto& [id, package] : packageOf) {
+                if (id == cpu.id) cpu.package = package;
+            }
+            for (size_t domain = 0; domain < topology.l3Domains.size(); domain++) {
+                const auto& members = topology.l3Domains[domain].cpus;
+                if (std::find(members.begin(), members.end(), cpu.id) != members.end()) {
+                    cpu.l3Domain = static_cast<int>(domain);
+                }
+            }
+        }
+        return topology;
+    }
+
 #else // PLATFORM_LINUX
 
     bool initializeSockets() {
@@ -250,6 +433,11 @@ namespace Platform {
         // No cleanup needed on Linux
     }
 
+    bool setSocketNonBlocking(socket_t socket) {
+        int flags = fcntl(socket, F_GETFL, 0);
+        return flags >= 0 && fcntl(socket, F_SETFL, flags | O_NONBLOCK) == 0;
+    }
+
     std::string getCPUBrand() {
         std::ifstream cpuinfo("/proc/cpuinfo");
         std::string line;
@@ -360,6 +548,78 @@ namespace Platform {
         }
     }
 
+    // First number in a file, or 0 ("max" and missing files read as no limit)
+    static uint64_t readSysfsNumber(const std::string& path) {
+        std::ifstream file(path);
+        uint64_t value = 0;
+        return (file >> value) ? value : 0;
+    }
+
+    // limit - usage for one cgroup level, UINT64_MAX when it sets no limit
+    static uint64_t cgroupLevelHeadroom(const std::string& limitFile, const std::string& usageFile) {
+        uint64_t limit = readSysfsNumber(limitFile);
+        if (limit == 0 || limit >= (1ull << 62)) return UINT64_MAX;  // "max", or v1's page-rounded INT64_MAX
+        uint64_t usage = readSysfsNumber(usageFile);
+        return limit > usage ? limit - usage : 0;
+    }
+
+    // Headroom left under the memory cgroup limit, UINT64_MAX without one
+    static uint64_t cgroupMemoryHeadroom() {
+        uint64_t headroom = UINT64_MAX;
+        std::ifstream cgroups("/proc/self/cgroup");
+        std::string line;
+        while (std::getline(cgroups, line)) {
+            // "hierarchy:controllers:path"; v2 has an empty controller list
+            size_t first = line.find(':');
+            size_t second = line.find(':', first + 1);
+            if (first == std::string::npos || second == std::string::npos) continue;
+            std::string controllers = line.substr(first + 1, second - first - 1);
+            std::string path = line.substr(second + 1);
+
+            if (controllers.empty()) {
+                // v2 limits apply per ancestor, so the tightest level wins
+                for (std::string dir = path; ; ) {
+                    std::string base = "/sys/fs/cgroup" + (dir == "/" ? std::string() : dir);
+                    headroom = (std::min)(headroom, cgroupLevelHeadroom(base + "/memory.max", base + "/memory.current"));
+                    if (dir.empty() || dir == "/") break;
+                    size_t slash = dir.find_last_of('/');
+                    dir = (slash == 0 || slash == std::string::npos) ? "/" : dir.substr(0, slash);
+                }
+            } else if (("," + controllers + ",").find(",memory,") != std::string::npos) {
+                // Inside a container the own path is often not mounted; the root is the container
+                std::string base = "/sys/fs/cgroup/memory" + path;
+                if (!std::filesystem::exists(base + "/memory.limit_in_bytes")) base = "/sys/fs/cgroup/memory";
+                headroom = (std::min)(headroom, cgroupLevelHeadroom(base + "/memory.limit_in_bytes", base + "/memory.usage_in_bytes"));
+            }
+        }
+        return headroom;
+    }
+
+    uint64_t getAvailableMemoryBytes() {
+        uint64_t available = 0;
+        uint64_t hugeFree = 0;
+        uint64_t hugePageKB = 0;
+        std::ifstream meminfo("/proc/meminfo");
+        std::string line;
+        while (std::getline(meminfo, line)) {
+            std::istringstream fields(line);
+            std::string key;
+            uint64_t value = 0;
+            fields >> key >> value;
+            if (key == "MemAvailable:") available = value * 1024;
+            else if (key == "HugePages_Free:") hugeFree = value;
+            else if (key == "Hugepagesize:") hugePageKB = value;
+        }
+        available = (std::min)(available, cgroupMemoryHeadroom());
+
+        // Reserved pools are outside MemAvailable and not charged to the memory cgroup
+        available += hugeFree * hugePageKB * 1024;
+        if (hugePageKB != 1048576) {
+            available += readSysfsNumber("/sys/kernel/mm/hugepages/hugepages-1048576kB/free_hugepages") << 30;
+        }
+        return available;
+    }
+
     std::string getMotherboardInfo() {
         std::string vendor, product;
         std::ifstream vendorFile("/sys/devices/virtual/dmi/id/board_vendor");
@@ -390,35 +650,56 @@ namespace Platform {
     }
     
     bool hasHugePagesSupport() {
-#if defined(__aarch64__) || defined(__arm__)
-        // ARM64: Check for THP (Transparent Huge Pages) support
-        std::ifstream thp("/sys/kernel/mm/transparent_hugepage/enabled");
-        if (thp) {
-            std::string line;
-            std::getline(thp, line);
-            // Check if THP is enabled (shows as "[always]" or "[madvise]")
-            return line.find("[always]") != std::string::npos || 
-                   line.find("[madvise]") != std::string::npos;
-        }
-        return false;
-#else
-        // x86_64: Check traditional huge pages
+        // MAP_HUGETLB only succeeds from a reserved pool; THP alone is
+        // handled by hasTransparentHugePages()
         std::ifstream meminfo("/proc/meminfo");
         std::string line;
         while (std::getline(meminfo, line)) {
-            if (line.find("Hugepagesize:") != std::string::npos) {
+            if (line.find("HugePages_Total:") != std::string::npos) {
                 size_t pos = line.find(':');
                 if (pos != std::string::npos) {
                     std::string value = line.substr(pos + 1);
                     value.erase(0, value.find_first_not_of(" \t"));
-                    int sizeKB = 0;
-                    try { sizeKB = std::stoi(value); } catch (...) { return false; }
-                    return sizeKB >= 2048; // At least 2MB
+                    int totalPages = 0;
+                    try { totalPages = std::stoi(value); } catch (...) { return false; }
+                    return totalPages > 0;
                 }
             }
         }
         return false;
-#endif
+    }
+    
+    bool hasTransparentHugePages() {
+        // Shows as "always [madvise] never"
+        std::ifstream thp("/sys/kernel/mm/transparent_hugepage/enabled");
+        std::string line;
+        if (!std::getline(thp, line)) return false;
+        return line.find("[always]") != std::string::npos ||
+               line.find("[madvise]") != std::string::npos;
+    }
+    
+    uint64_t getTransparentHugePagesBytes(const void* addr, size_t bytes) {
+        uintptr_t begin = reinterpret_cast<uintptr_t>(addr);
+        uintptr_t end = begin + bytes;
+        std::ifstream smaps("/proc/self/smaps");
+        std::string line;
+        bool inRange = false;
+        uint64_t total = 0;
+        while (std::getline(smaps, line)) {
+            // Mapping header: "7f12c0000000-7f1340000000 rw-p 00000000 00:00 0"
+            size_t dash = line.find('-');
+            size_t space = line.find(' ');
+            if (dash != std::string::npos && space != std::string::npos && dash < space &&
+                line.find_first_not_of("0123456789abcdef") == dash) {
+                uintptr_t start = std::stoull(line.substr(0, dash), nullptr, 16);
+                uintptr_t stop = std::stoull(line.substr(dash + 1, space - dash - 1), nullptr, 16);
+                inRange = start < end && stop > begin;
+            }
+            else if (inRange && line.compare(0, 14, "AnonHugePages:") == 0) {
+                total += std::stoull(line.substr(14)) * 1024;
+            }
+        }
+        return total;
     }
     
     bool has1GBPagesSupport() {
@@ -433,16 +714,11 @@ namespace Platform {
             if (line.find("pdpe1gb") != std::string::npos) {
                 cpuinfo.close();
                 
-                // Check if 1GB pages are configured in kernel
-                std::ifstream meminfo("/proc/meminfo");
-                while (std::getline(meminfo, line)) {
-                    if (line.find("Hugepagesize:") != std::string::npos) {
-                        if (line.find("1048576 kB") != std::string::npos) {
-                            return true;
-                        }
-                    }
-                }
-                return false;
+                // 1GB pages must be reserved, e.g. hugepagesz=1G hugepages=3 or via sysfs;
+                // the default Hugepagesize can stay at 2MB
+                std::ifstream reserved("/sys/kernel/mm/hugepages/hugepages-1048576kB/nr_hugepages");
+                unsigned long pages = 0;
+                return (reserved >> pages) && pages > 0;
             }
         }
         return false;
@@ -541,10 +817,162 @@ namespace Platform {
             return ss.str();
         }
         
-        return "unavailable";
+        return hasTransparentHugePages() ? "no reserved pages (THP fallback)" : "unavailable";
 #endif
     }
 
+    void lowerCurrentThreadPriority() {
+        // On Linux the nice value is per thread when addressed by tid
+        setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), 19);
+    }
+
+    std::vector<NumaNode> getNumaNodes() {
+        std::vector<NumaNode> nodes;
+        std::error_code ec;
+        for (const auto& entry : std::filesystem::directory_iterator("/sys/devices/system/node", ec)) {
+            std::string name = entry.path().filename().string();
+            if (name.size() <= 4 || name.compare(0, 4, "node") != 0 ||
+                !std::all_of(name.begin() + 4, name.end(), [](char c) { return isdigit(static_cast<unsigned char>(c)); })) {
+                continue;
+            }
+            std::ifstream cpulist(entry.path() / "cpulist");
+            std::string line;
+            std::getline(cpulist, line);
+            NumaNode node{std::stoi(name.substr(4)), parseCpuList(line)};
+            if (!node.cpus.empty()) {
+                nodes.push_back(node);  // Memory-only nodes have no CPUs to run on
+            }
+        }
+        std::sort(nodes.begin(), nodes.end(), [](const NumaNode& a, const NumaNode& b) { return a.id < b.id; });
+        return nodes.empty() ? singleNumaNode() : nodes;
+    }
+
+    bool pinCurrentThread(const std::vector<unsigned int>& cpus) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (unsigned int cpu : cpus) {
+            if (cpu < CPU_SETSIZE) CPU_SET(cpu, &set);
+        }
+        return !cpus.empty() && pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+    }
+
+    bool setCurrentThreadMemoryNodes(const std::vector<int>& nodes) {
+#ifdef SYS_set_mempolicy
+        // set_mempolicy(2) directly, so libnuma is not a dependency
+        constexpr int POLICY_DEFAULT = 0;
+        constexpr int POLICY_INTERLEAVE = 3;
+        constexpr size_t MAX_NODES = 1024;
+        constexpr size_t WORD_BITS = 8 * sizeof(unsigned long);
+        if (nodes.empty()) {
+            return syscall(SYS_set_mempolicy, POLICY_DEFAULT, nullptr, 0) == 0;
+        }
+        unsigned long mask[MAX_NODES / WORD_BITS] = {};
+        for (int node : nodes) {
+            if (node >= 0 && static_cast<size_t>(node) < MAX_NODES) {
+                mask[node / WORD_BITS] |= 1ul << (node % WORD_BITS);
+            }
+        }
+        return syscall(SYS_set_mempolicy, POLICY_INTERLEAVE, mask, MAX_NODES + 1) == 0;
+#else
+        (void)nodes;
+        return false;
+#endif
+    }
+
+    uint64_t getNumaNodeBytes(const void* addr, size_t bytes, int node) {
+        // "7f12c0000000 default anon=524288 dirty=524288 N0=262144 N1=262144 kernelpagesize_kB=4",
+        // sorted by start address; the mapping holding addr may start below it
+        uintptr_t begin = reinterpret_cast<uintptr_t>(addr);
+        uintptr_t end = begin + bytes;
+        std::string nodeKey = "N" + std::to_string(node) + "=";
+        std::ifstream numaMaps("/proc/self/numa_maps");
+        std::string line;
+        uint64_t total = 0;
+        uint64_t containing = 0;  // Last mapping starting at or below addr
+        while (std::getline(numaMaps, line)) {
+            uintptr_t start = std::strtoull(line.c_str(), nullptr, 16);
+            if (start >= end) break;
+            uint64_t pages = 0;
+            uint64_t pageKiB = 4;
+            std::istringstream fields(line);
+            std::string field;
+            while (fields >> field) {
+                if (field.compare(0, nodeKey.size(), nodeKey) == 0) {
+                    pages = std::strtoull(field.c_str() + nodeKey.size(), nullptr, 10);
+                } else if (field.compare(0, 18, "kernelpagesize_kB=") == 0) {
+                    pageKiB = std::strtoull(field.c_str() + 18, nullptr, 10);
+                }
+            }
+            if (start <= begin) {
+                containing = pages * pageKiB * 1024;
+            } else {
+                total += pages * pageKiB * 1024;
+            }
+        }
+        return (std::min)(static_cast<uint64_t>(bytes), total + containing);
+    }
+
+    static std::string readSysfsLine(const std::string& path) {
+        std::ifstream file(path);
+        std::string line;
+        std::getline(file, line);
+        return line;
+    }
+
+    // sysfs cache sizes look like "32768K"
+    static uint64_t parseCacheSize(const std::string& text) {
+        if (text.empty() || !isdigit(static_cast<unsigned char>(text[0]))) return 0;
+        uint64_t size = std::stoull(text);
+        switch (text.back()) {
+            case 'K': return size << 10;
+            case 'M': return size << 20;
+            case 'G': return size << 30;
+            default:  return size;
+        }
+    }
+
+    CpuTopology getCpuTopology() {
+        CpuTopology topology;
+        const std::string base = "/sys/devices/system/cpu/";
+        std::vector<unsigned int> online = parseCpuList(readSysfsLine(base + "online"));
+        if (online.empty()) {
+            for (unsigned int cpu = 0; cpu < getLogicalProcessors(); cpu++) online.push_back(cpu);
+        }
+
+        std::vector<std::string> domainKeys;  // shared_cpu_list of each L3 domain
+        for (unsigned int cpu : online) {
+            std::string dir = base + "cpu" + std::to_string(cpu) + "/";
+            LogicalCpu info{cpu, 0, static_cast<int>(cpu), 0, -1};
+
+            std::string package = readSysfsLine(dir + "topology/physical_package_id");
+            std::string core = readSysfsLine(dir + "topology/core_id");
+            if (!package.empty() && isdigit(static_cast<unsigned char>(package[0]))) info.package = std::stoi(package);
+            if (!core.empty() && isdigit(static_cast<unsigned char>(core[0]))) info.core = std::stoi(core);
+
+            std::vector<unsigned int> siblings = parseCpuList(readSysfsLine(dir + "topology/thread_siblings_list"));
+            auto self = std::find(siblings.begin(), siblings.end(), cpu);
+            if (self != siblings.end()) info.smtIndex = static_cast<int>(self - siblings.begin());
+
+            for (int index = 0; ; index++) {
+                std::string cacheDir = dir + "cache/index" + std::to_string(index) + "/";
+                std::string level = readSysfsLine(cacheDir + "level");
+                if (level.empty()) break;
+                if (level != "3") continue;
+
+                std::string shared = readSysfsLine(cacheDir + "shared_cpu_list");
+                auto known = std::find(domainKeys.begin(), domainKeys.end(), shared);
+                if (known == domainKeys.end()) {
+                    topology.l3Domains.push_back({parseCacheSize(readSysfsLine(cacheDir + "size")), parseCpuList(shared)});
+                    domainKeys.push_back(shared);
+                    known = domainKeys.end() - 1;
+                }
+                info.l3Domain = static_cast<int>(known - domainKeys.begin());
+            }
+            topology.cpus.push_back(info);
+        }
+        return topology;
+    }
+
 #endif
 
 } // namespace Platform
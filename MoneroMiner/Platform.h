@@ -36,6 +36,8 @@
     #define SOCKET_ERROR_VALUE SOCKET_ERROR
     #define GET_SOCKET_ERROR() WSAGetLastError()
     #define WOULD_BLOCK WSAEWOULDBLOCK
+    #define CONNECT_IN_PROGRESS WSAEWOULDBLOCK  // Non-blocking connect() started
+    #define SEND_NO_SIGNAL 0
 #else
     #define PLATFORM_LINUX
 
@@ -58,12 +60,15 @@
     #define SOCKET_ERROR_VALUE -1
     #define GET_SOCKET_ERROR() errno
     #define WOULD_BLOCK EWOULDBLOCK
+    #define CONNECT_IN_PROGRESS EINPROGRESS  // Non-blocking connect() started
+    #define SEND_NO_SIGNAL MSG_NOSIGNAL  // A closed pool socket is an error, not SIGPIPE
 #endif
 
 // Cross-platform socket initialization and helpers
 namespace Platform {
     bool initializeSockets();
     void cleanupSockets();
+    bool setSocketNonBlocking(socket_t socket);
 
     std::string getCPUBrand();
     std::string getCPUFeatures();
@@ -71,6 +76,10 @@ namespace Platform {
 
     // returns usedGB, totalGB and usage percent
     void getMemoryInfo(double& usedGB, double& totalGB, int& usage);
+    
+    // Memory this process can still allocate: available RAM capped by the
+    // cgroup limit (Linux), plus free reserved huge pages, which neither counts
+    uint64_t getAvailableMemoryBytes();
 
     std::string getMotherboardInfo();
     unsigned int getLogicalProcessors();
@@ -78,8 +87,59 @@ namespace Platform {
     bool isRunningElevated();
     
     // Huge pages support
-    bool hasHugePagesSupport();      // Check if 2MB pages available
+    bool hasHugePagesSupport();      // Check if 2MB pages available (reserved pool on Linux)
     bool has1GBPagesSupport();       // Check if 1GB pages available (Linux only)
     size_t getHugePageSize();        // Returns actual huge page size (2MB or 1GB)
     std::string getHugePagesStatus(); // Detailed status string
+    bool hasTransparentHugePages();  // THP set to always or madvise (Linux only)
+    
+    // Bytes of [addr, addr + bytes) the kernel backs with transparent huge pages
+    // (AnonHugePages in /proc/self/smaps), 0 where THP does not exist
+    uint64_t getTransparentHugePagesBytes(const void* addr, size_t bytes);
+    
+    // Background work (e.g. next dataset build) yields to the mining threads
+    void lowerCurrentThreadPriority();
+    
+    // NUMA topology: nodes that have CPUs, with their logical CPU numbers.
+    // Always returns at least one node (all CPUs) if the OS reports none.
+    struct NumaNode {
+        int id;
+        std::vector<unsigned int> cpus;
+    };
+    std::vector<NumaNode> getNumaNodes();
+    
+    // Restrict the calling thread to the given logical CPUs
+    bool pinCurrentThread(const std::vector<unsigned int>& cpus);
+    
+    // Pages the calling thread faults in from now on are interleaved over the
+    // given node ids; {} restores the default (the faulting CPU's node).
+    // Linux only. Needed for allocations populated inside mmap (hugetlb with
+    // MAP_POPULATE), whose placement first touch can no longer change.
+    bool setCurrentThreadMemoryNodes(const std::vector<int>& nodes);
+    
+    // Bytes of the mappings covering [addr, addr + bytes) that sit on node
+    // (/proc/self/numa_maps), 0 where this is unknown
+    uint64_t getNumaNodeBytes(const void* addr, size_t bytes, int node);
+    
+    // CPU topology for thread placement: which logical CPUs share a core
+    // (SMT siblings) and which share an L3 cache (CCX / die / socket)
+    struct LogicalCpu {
+        unsigned int id;
+        int package;
+        int core;       // Unique within its package
+        int smtIndex;   // 0 for the first thread of a core, 1+ for its siblings
+        int l3Domain;   // Index into CpuTopology::l3Domains, -1 if unknown
+    };
+    struct CacheDomain {
+        uint64_t sizeBytes;
+        std::vector<unsigned int> cpus;
+    };
+    struct CpuTopology {
+        std::vector<LogicalCpu> cpus;
+        std::vector<CacheDomain> l3Domains;
+    };
+    CpuTopology getCpuTopology();
+    
+    // "0-7,16-23" style CPU list (sysfs format, also used by --cpu-list)
+    std::vector<unsigned int> parseCpuList(const std::string& list);
 }
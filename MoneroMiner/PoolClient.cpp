@@ -5,29 +5,38 @@
 #include "RandomXManager.h"
 #include "MiningStats.h"
 #include "Platform.h"  // Replace ws2tcpip.h
+#include "ShareQueue.h"
+#include "EventLoop.h"
+#include "LineBuffer.h"
+#include "Stratum.h"
 #include <iostream>
 #include <sstream>
 #include <iomanip>
 #include <chrono>
 #include <thread>
 #include <cstring>
+#include <cctype>
+#include <deque>
+#include <algorithm>
+#include <unordered_map>
 #include "picojson.h"
 
 using namespace picojson;
 
 namespace PoolClient {
+    using Clock = std::chrono::steady_clock;
+
     // Static member definitions
-    socket_t poolSocket = INVALID_SOCKET_VALUE;
     std::mutex jobMutex;
-    std::queue<Job> jobQueue;
+    alignas(64) std::atomic<uint64_t> jobGeneration(0);
+    static std::shared_ptr<const Job> publishedJob;  // Accessed only via std::atomic_load/store
+    static std::mutex jobWakeMutex;                   // Pairs with jobWakeCondition only
+    static std::condition_variable jobWakeCondition;  // Idle mining threads block here
     std::condition_variable jobAvailable;
-    std::condition_variable jobQueueCondition;
     std::atomic<bool> shouldStop(false);
     std::string currentSeedHash;
-    std::string sessionId;
     std::string currentTargetHex;
     std::vector<std::shared_ptr<MiningThreadData>> threadData;
-    std::mutex socketMutex;
     std::mutex submitMutex; // <- define the mutex here (matches extern in header)
     static std::chrono::steady_clock::time_point lastSubmitTime;
     std::string poolId;
@@ -37,638 +46,1276 @@ namespace PoolClient {
     // static std::chrono::steady_clock::time_point lastShareTime;
     // static std::mutex shareMutex;
 
-    // Forward declarations
-    bool sendRequest(const std::string& request);
-    void processNewJob(const picojson::object& jobObj);
-    bool processShareResponse(const std::string& response);
+    // Share pipeline: mining threads push into shareQueue, the job listener
+    // thread drains it and sends the submits
+    static ShareQueue shareQueue;
 
-    bool processShareResponse(const std::string& response) {
-        if (response.empty()) {
-            return true;
+    // Every request sent after connecting waits in its pool's table for the
+    // reply, keyed by JSON-RPC id. Any number can be in flight; replies are
+    // matched by id in whatever order they arrive between job pushes.
+    struct PendingRequest {
+        enum Kind { LOGIN, GETJOB, SUBMIT, KEEPALIVE } kind;
+        std::string payload;   // Resent as-is, same id, on a submit timeout
+        std::string jobId;     // Submit only
+        std::string nonceHex;  // Submit only
+        uint64_t generation;   // Submit only: job snapshot the share is for
+        std::chrono::steady_clock::time_point foundAt;  // Submit only
+        std::chrono::steady_clock::time_point sentAt;
+        int attempts;
+        bool stalled;          // Reply waited behind a blocking job switch; no RTT sample
+    };
+    static const int REQUEST_TIMEOUT_SECONDS = 10;
+    static const int SUBMIT_ATTEMPTS = 2;
+
+    // Own copy of a job, kept for a pool whose jobs are not being mined so a
+    // failover can publish it at once
+    struct StoredJob {
+        std::string blob, jobId, target, seedHash, nextSeedHash, algo;
+        uint64_t height = 0;
+
+        void assign(const Stratum::JobFields& fields) {
+            blob.assign(fields.blob.data(), fields.blob.size());
+            jobId.assign(fields.jobId.data(), fields.jobId.size());
+            target.assign(fields.target.data(), fields.target.size());
+            seedHash.assign(fields.seedHash.data(), fields.seedHash.size());
+            nextSeedHash.assign(fields.nextSeedHash.data(), fields.nextSeedHash.size());
+            algo.assign(fields.algo.data(), fields.algo.size());
+            height = fields.height;
+        }
+        Stratum::JobFields fields() const {
+            Stratum::JobFields fields;
+            fields.blob = blob;
+            fields.jobId = jobId;
+            fields.target = target;
+            fields.seedHash = seedHash;
+            fields.nextSeedHash = nextSeedHash;
+            fields.algo = algo;
+            fields.height = height;
+            return fields;
         }
+    };
 
-        try {
-            picojson::value v;
-            std::string err = picojson::parse(v, response);
-            if (err.empty() && v.is<picojson::object>()) {
-                const picojson::object& obj = v.get<picojson::object>();
-                
-                if (config.debugMode) {
-                    Utils::threadSafePrint("Processing additional response data: " + v.serialize(), true);
-                }
+    // One connection per configured pool (Config::getPools() order). The
+    // active session's jobs are mined; one other logged-in session is kept as
+    // a hot standby, receiving jobs and keepalives, so a failover needs no
+    // connect or login. Health counters survive reconnects.
+    struct PoolSession {
+        enum State { CLOSED, CONNECTING, LOGGING_IN, READY };
 
-                // Check if response contains a new job (pool often sends new job with share response)
-                if (obj.find("method") != obj.end() && obj.at("method").get<std::string>() == "job") {
-                    if (obj.find("params") != obj.end() && obj.at("params").is<picojson::object>()) {
-                        const picojson::object& params = obj.at("params").get<picojson::object>();
-                        
-                        std::string blobStr = params.at("blob").get<std::string>();
-                        std::string jobId = params.at("job_id").get<std::string>();
-                        std::string target = params.at("target").get<std::string>();
-                        uint64_t height = static_cast<uint64_t>(params.at("height").get<double>());
-                        std::string seedHash = params.at("seed_hash").get<std::string>();
-
-                        if (!RandomXManager::setTargetAndDifficulty(target)) {
-                            Utils::threadSafePrint("Failed to set target for new job", true);
-                            return true;
-                        }
+        size_t index = 0;
+        PoolEndpoint endpoint;
+        State state = CLOSED;
+        socket_t socket = INVALID_SOCKET_VALUE;
+        std::string sessionId;
+        LineBuffer rx;    // recv() target, split into lines in place
+        std::string tx;   // Requests the socket has not taken yet
+        std::unordered_map<uint64_t, PendingRequest> pending;
+        Clock::time_point stateSince;
+        Clock::time_point nextKeepalive;
+        StoredJob latestJob;
+        bool hasJob = false;
 
-                        Job job(blobStr, jobId, target, height, seedHash);
-                        distributeJob(job);
-                    }
-                }
-                
-                return true;
-            }
+        double rttMs = 0;  // Moving average of request round trips, 0 until measured
+        uint64_t accepted = 0;
+        uint64_t rejected = 0;
+        uint64_t stale = 0;  // Rejections that said the job was outdated
+        int failures = 0;    // Since the last successful login
+        Clock::time_point retryAt;
+
+        std::string name() const {
+            return endpoint.host + ":" + std::to_string(endpoint.port);
         }
-        catch (const std::exception& e) {
-            if (config.debugMode) {
-                Utils::threadSafePrint("Error processing share response: " + std::string(e.what()), true);
-            }
+    };
+
+    // The network thread is a reactor: it alone reads and writes the pool
+    // sockets, sends keepalives and submits, and connects, fails over and
+    // switches between pools. Everything below is touched by that thread
+    // only (login() runs the same loop before the thread starts).
+    static EventLoop networkLoop;
+    static std::vector<std::unique_ptr<PoolSession>> sessions;
+    static PoolSession* active = nullptr;  // Pool whose jobs are mined
+    static Clock::time_point activeSince;  // Zero until the first pool is mined
+    static Clock::time_point lastProbe;
+    static picojson::object loginParams;   // Set by login(), sent to every pool
+    static const int KEEPALIVE_SECONDS = 30;
+    static const int CONNECT_TIMEOUT_SECONDS = 10;
+    static const int PROBE_INTERVAL_SECONDS = 300;  // Reconnect idle pools to re-measure them
+    static const int SELECT_INTERVAL_SECONDS = 60;  // Least time on a pool before switching for speed
+    static constexpr double SWITCH_MARGIN = 0.75;   // Standby must score this much better
+    static constexpr double RTT_WEIGHT = 0.125;     // Same smoothing as the stats line
+    static const int RECONNECT_MAX_SECONDS = 60;
+    static const int STANDBY_POLL_MS = 250;  // While a background dataset build or a straggling thread is awaited
+
+    // Last few published jobs, so a share found just before a job switch is
+    // still sent under the job id it was hashed for, to the pool that sent
+    // the job. Guarded by jobMutex.
+    struct RecentJob {
+        uint64_t generation;
+        std::string jobId;
+        size_t pool;
+    };
+    static std::deque<RecentJob> recentJobIds;
+    static const size_t RECENT_JOB_COUNT = 4;
+
+    // First job of a new seed, held back while its dataset is built in the
+    // background (--dataset-double-buffer). Guarded by jobMutex.
+    static std::unique_ptr<Job> deferredJob;
+    static std::chrono::steady_clock::time_point deferredSince;  // Epoch flip seen by the pool
+
+    // Mining threads have to move past these generations before the dataset
+    // they read is rebuilt in place (parked) or freed after a swap (retired).
+    // Zero when nothing waits. Guarded by jobMutex.
+    static uint64_t parkedGeneration = 0;
+    static uint64_t retiredGeneration = 0;
+    static const int THREAD_RELEASE_TIMEOUT_MS = 30000;
+
+    // Forward declarations
+    static bool sendRequest(PoolSession& session, const std::string& request);
+    static void processJob(const Stratum::JobFields& fields, size_t pool);
+    static void failSession(PoolSession& session, const std::string& reason);
+    static void publishDeferredJob();
+    static void publishFullModeUpgrade();
+    static bool waitingForThreads();
+    static void releaseRetiredWhenIdle();
+
+    // Queue a found share - the only share work done on a mining thread
+    bool queueShare(uint64_t generation, uint32_t nonce, const uint8_t* hash) {
+        ShareSubmission share;
+        share.generation = generation;
+        share.nonce = nonce;
+        std::memcpy(share.hash, hash, sizeof(share.hash));
+        share.foundAt = std::chrono::steady_clock::now();
+        if (!shareQueue.push(share)) {
+            return false;
         }
-        
+        networkLoop.wake();
         return true;
     }
 
-    bool submitShare(const std::string& jobId, const std::string& nonceHex,
-                     const std::string& hashHex, const std::string& algo) {
-        (void)algo; // silence unused parameter
-        if (sessionId.empty()) {
-            Utils::threadSafePrint("Cannot submit: No session", true);
+    void wakeNetworkThread() {
+        networkLoop.wake();
+    }
+
+    // Job id and pool a generation was published under; false once it is too old
+    static bool jobForGeneration(uint64_t generation, std::string& jobId, size_t& pool) {
+        std::lock_guard<std::mutex> lock(jobMutex);
+        for (const RecentJob& entry : recentJobIds) {
+            if (entry.generation == generation) {
+                jobId = entry.jobId;
+                pool = entry.pool;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Send a request and file it under its id; the reply is matched in handleMessage
+    static bool sendTracked(PoolSession& session, uint64_t requestId, PendingRequest request) {
+        if (!sendRequest(session, request.payload)) {
             return false;
         }
-        
+        request.sentAt = std::chrono::steady_clock::now();
+        request.attempts = 1;
+        request.stalled = false;
+        session.pending[requestId] = std::move(request);
+        return true;
+    }
+
+    // Send one submit without waiting for its reply
+    static bool submitShare(PoolSession& session, const std::string& jobId, const std::string& nonceHex,
+                            const std::string& hashHex, uint64_t generation,
+                            std::chrono::steady_clock::time_point foundAt) {
+        uint64_t requestId = jsonRpcId.fetch_add(1);
+
         picojson::object submitObj;
-        submitObj["id"] = picojson::value(static_cast<double>(jsonRpcId.fetch_add(1)));
+        submitObj["id"] = picojson::value(static_cast<double>(requestId));
         submitObj["jsonrpc"] = picojson::value("2.0");
         submitObj["method"] = picojson::value("submit");
-        
+
         picojson::object params;
-        params["id"] = picojson::value(sessionId);
+        params["id"] = picojson::value(session.sessionId);
         params["job_id"] = picojson::value(jobId);
         params["nonce"] = picojson::value(nonceHex);
         params["result"] = picojson::value(hashHex);
-        
+
         submitObj["params"] = picojson::value(params);
-        
+
         std::string payload = picojson::value(submitObj).serialize();
-        
+
         if (config.debugMode) {
             Utils::threadSafePrint("Submit: " + payload, true);
         }
-        
-        // Send the share and get response
-        std::string response = sendAndReceive(payload);
-        
-        // Check response for errors FIRST
-        bool hasError = false;
-        if (!response.empty()) {
-            try {
-                picojson::value v;
-                std::string err = picojson::parse(v, response);
-                if (err.empty() && v.is<picojson::object>()) {
-                    const picojson::object& obj = v.get<picojson::object>();
-                    if (obj.find("error") != obj.end() && !obj.at("error").is<picojson::null>()) {
-                        hasError = true;
-                    }
-                }
-            } catch (...) {
-                // If we can't parse it, check if it contains "error" keyword as a fallback
-                if (response.find("\"error\"") != std::string::npos &&
-                    response.find("\"error\":null") == std::string::npos) {
-                    hasError = true;
+
+        PendingRequest request;
+        request.kind = PendingRequest::SUBMIT;
+        request.payload = std::move(payload);
+        request.jobId = jobId;
+        request.nonceHex = nonceHex;
+        request.generation = generation;
+        request.foundAt = foundAt;
+        return sendTracked(session, requestId, std::move(request));
+    }
+
+    // Drain the share queue (network thread). Each share goes to the pool
+    // whose job it was hashed for, which need not be the active one.
+    static void submitQueuedShares() {
+        ShareSubmission share;
+        while (shareQueue.pop(share)) {
+            std::string jobId;
+            size_t pool = 0;
+            if (!jobForGeneration(share.generation, jobId, pool) || sessions[pool]->state != PoolSession::READY) {
+                if (config.debugMode) {
+                    Utils::threadSafePrint("Discarding share for retired job generation " + std::to_string(share.generation), true);
                 }
+                continue;
+            }
+            PoolSession& session = *sessions[pool];
+
+            std::string nonceHex = Utils::nonceToHex(share.nonce);
+            std::string hashHex = Utils::bytesToHex(share.hash, sizeof(share.hash));
+            Utils::threadSafePrint("Share found! J: " + jobId + " Nonce: " + nonceHex, true);
+            Utils::threadSafePrint("Hash: " + hashHex, true);
+
+            if (!submitShare(session, jobId, nonceHex, hashHex, share.generation, share.foundAt)) {
+                failSession(session, "send failed");
             }
         }
-        
-        // Only count as accepted if NO error was found
-        if (!hasError) {
-            MiningStatsUtil::acceptedShares++;
-            Utils::threadSafePrint("Share submitted - ACCEPTED (Total: " + 
-                                 std::to_string(MiningStatsUtil::acceptedShares.load()) + ")", true);
-            
-            // Process response for any additional info (like new jobs)
-            if (!response.empty()) {
-                processShareResponse(response);
+    }
+
+    static std::string errorMessage(const picojson::value& errorVal) {
+        if (errorVal.is<picojson::object>()) {
+            const picojson::object& errorObj = errorVal.get<picojson::object>();
+            if (errorObj.find("message") != errorObj.end() && errorObj.at("message").is<std::string>()) {
+                return errorObj.at("message").get<std::string>();
             }
-            return true;
-        } else {
-            // Error found - count as rejected
-            MiningStatsUtil::rejectedShares++;
-            
-            // Parse the actual error message
-            std::string errorMsg = "Unknown error";
-            try {
-                picojson::value v;
-                std::string err = picojson::parse(v, response);
-                if (err.empty() && v.is<picojson::object>()) {
-                    const picojson::object& obj = v.get<picojson::object>();
-                    if (obj.find("error") != obj.end()) {
-                        const picojson::value& errorVal = obj.at("error");
-                        if (errorVal.is<picojson::object>()) {
-                            const picojson::object& errorObj = errorVal.get<picojson::object>();
-                            if (errorObj.find("message") != errorObj.end()) {
-                                errorMsg = errorObj.at("message").get<std::string>();
-                            }
-                        } else if (errorVal.is<std::string>()) {
-                            errorMsg = errorVal.get<std::string>();
-                        }
-                    }
-                }
-            } catch (...) {
-                // Keep default error message
+        } else if (errorVal.is<std::string>()) {
+            return errorVal.get<std::string>();
+        }
+        return "Unknown error";
+    }
+
+    // Pools word it differently; all of these mean the job was already replaced
+    static bool isStaleRejection(std::string message) {
+        std::transform(message.begin(), message.end(), message.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        for (const char* word : { "stale", "expired", "outdated", "job not found", "invalid job" }) {
+            if (message.find(word) != std::string::npos) {
+                return true;
             }
-            
-            Utils::threadSafePrint("Share REJECTED: " + errorMsg + 
-                                 " (Accepted: " + std::to_string(MiningStatsUtil::acceptedShares.load()) +
-                                 ", Rejected: " + std::to_string(MiningStatsUtil::rejectedShares.load()) + ")", true);
-            return false;
         }
+        return false;
     }
 
-    // sendRequest: lock socket and send newline-terminated JSON
-    bool sendRequest(const std::string& request) {
-        std::lock_guard<std::mutex> lock(socketMutex);
-        if (poolSocket == INVALID_SOCKET_VALUE) {
-            Utils::threadSafePrint("Cannot send: Invalid socket", true);
+    // Jobs the Stratum decoder did not take (login and getjob replies,
+    // unusual formatting) arrive as a picojson tree; fields point into it
+    static bool jobFromObject(const picojson::object& jobData, Stratum::JobFields& fields) {
+        try {
+            fields.blob = jobData.at("blob").get<std::string>();
+            fields.jobId = jobData.at("job_id").get<std::string>();
+            fields.target = jobData.at("target").get<std::string>();
+            fields.height = static_cast<uint64_t>(jobData.at("height").get<double>());
+            fields.seedHash = jobData.at("seed_hash").get<std::string>();
+            auto nextSeed = jobData.find("next_seed_hash");
+            if (nextSeed != jobData.end() && nextSeed->second.is<std::string>()) {
+                fields.nextSeedHash = nextSeed->second.get<std::string>();
+            }
+            auto algo = jobData.find("algo");
+            if (algo != jobData.end() && algo->second.is<std::string>()) {
+                fields.algo = algo->second.get<std::string>();
+            }
+            return true;
+        }
+        catch (const std::exception& e) {
+            Utils::threadSafePrint("Error processing job: " + std::string(e.what()), true);
             return false;
         }
+    }
+
+    // A job from a pool: mined if the pool is active, otherwise kept for a
+    // failover to it
+    static void deliverJob(PoolSession& session, const Stratum::JobFields& fields) {
+        session.latestJob.assign(fields);
+        session.hasJob = true;
+        if (&session == active) {
+            processJob(fields, session.index);
+        }
+    }
+
+    static void handleLoginReply(PoolSession& session, const picojson::object& obj) {
+        auto errorIt = obj.find("error");
+        if (errorIt != obj.end() && !errorIt->second.is<picojson::null>()) {
+            failSession(session, "login error: " + errorMessage(errorIt->second));
+            return;
+        }
+        auto resultIt = obj.find("result");
+        if (resultIt == obj.end() || !resultIt->second.is<picojson::object>()) {
+            failSession(session, "unexpected login response format");
+            return;
+        }
+        const picojson::object& result = resultIt->second.get<picojson::object>();
+        auto idIt = result.find("id");
+        if (idIt == result.end() || !idIt->second.is<std::string>()) {
+            failSession(session, "login response without a session id");
+            return;
+        }
 
-        std::string requestWithNewline = request + "\n";
-        int sendResult = send(poolSocket, requestWithNewline.c_str(), static_cast<int>(requestWithNewline.length()), 0);
-        if (sendResult == SOCKET_ERROR_VALUE) {
-            Utils::threadSafePrint("send failed: " + std::to_string(GET_SOCKET_ERROR()), true);
+        auto now = Clock::now();
+        session.sessionId = idIt->second.get<std::string>();
+        session.state = PoolSession::READY;
+        session.stateSince = now;
+        session.nextKeepalive = now + std::chrono::seconds(KEEPALIVE_SECONDS);
+        session.failures = 0;
+        std::stringstream ss;
+        ss << "Logged in to " << session.name() << " (Session ID: " << session.sessionId
+           << ", rtt " << std::fixed << std::setprecision(1) << session.rttMs << " ms)";
+        Utils::threadSafePrint(ss.str(), true);
+
+        auto jobIt = result.find("job");
+        Stratum::JobFields fields;
+        if (jobIt != result.end() && jobIt->second.is<picojson::object>() &&
+            jobFromObject(jobIt->second.get<picojson::object>(), fields)) {
+            deliverJob(session, fields);
+        }
+    }
+
+    // Reply to one of our requests: record its round trip and act on it.
+    // Returns false if the id is not in the pool's request table.
+    static bool processReply(PoolSession& session, uint64_t requestId, const picojson::object& obj) {
+        auto it = session.pending.find(requestId);
+        if (it == session.pending.end()) {
             return false;
         }
+        PendingRequest request = std::move(it->second);
+        session.pending.erase(it);
+
+        auto now = std::chrono::steady_clock::now();
+        double rttMs = std::chrono::duration<double, std::milli>(now - request.sentAt).count();
+        if (!request.stalled) {
+            session.rttMs = session.rttMs == 0 ? rttMs : session.rttMs + (rttMs - session.rttMs) * RTT_WEIGHT;
+            if (&session == active) {
+                MiningStatsUtil::recordPoolLatency(rttMs);
+            }
+        }
+
+        if (request.kind == PendingRequest::LOGIN) {
+            handleLoginReply(session, obj);
+            return true;
+        }
+        if (request.kind == PendingRequest::GETJOB) {
+            auto resultIt = obj.find("result");
+            Stratum::JobFields fields;
+            if (resultIt != obj.end() && resultIt->second.is<picojson::object>() &&
+                jobFromObject(resultIt->second.get<picojson::object>(), fields)) {
+                deliverJob(session, fields);
+            }
+            return true;
+        }
+        if (request.kind == PendingRequest::KEEPALIVE) {
+            if (config.debugMode) {
+                std::stringstream ss;
+                ss << "[KEEPALIVE] " << session.name() << " replied to request " << requestId << " in "
+                   << std::fixed << std::setprecision(1) << rttMs << " ms";
+                Utils::threadSafePrint(ss.str(), true);
+            }
+            return true;
+        }
+
+        double latencyMs = std::chrono::duration<double, std::milli>(now - request.foundAt).count();
+        std::stringstream latency;
+        latency << std::fixed << std::setprecision(1) << latencyMs << " ms, rtt " << rttMs << " ms";
+
+        auto errorIt = obj.find("error");
+        if (errorIt == obj.end() || errorIt->second.is<picojson::null>()) {
+            session.accepted++;
+            MiningStatsUtil::acceptedShares++;
+            Utils::threadSafePrint("Share submitted - ACCEPTED (Total: " +
+                                 std::to_string(MiningStatsUtil::acceptedShares.load()) + ", " + latency.str() + ")", true);
+        } else {
+            session.rejected++;
+            MiningStatsUtil::rejectedShares++;
+
+            std::string errorMsg = errorMessage(errorIt->second);
+            if (isStaleRejection(errorMsg)) {
+                session.stale++;
+            }
+
+            Utils::threadSafePrint("Share REJECTED: " + errorMsg + " (J: " + request.jobId + " Nonce: " + request.nonceHex +
+                                 ", Accepted: " + std::to_string(MiningStatsUtil::acceptedShares.load()) +
+                                 ", Rejected: " + std::to_string(MiningStatsUtil::rejectedShares.load()) + ", " + latency.str() + ")", true);
+        }
         return true;
     }
 
-    // Helper: compute nfds for select on each platform
-    static inline int select_nfds(socket_t s) {
-    #ifdef PLATFORM_WINDOWS
-        (void)s;
-        return 0;
-    #else
-        return static_cast<int>(s) + 1;
-    #endif
+    // Requests without a reply after REQUEST_TIMEOUT_SECONDS. A submit whose
+    // job is still live is sent again under the same id, so whichever reply
+    // comes first settles it and a late one is ignored; otherwise the share
+    // is dropped, since the pool would only reject it as stale. An unanswered
+    // login fails the session; keepalives and getjobs are just dropped - a
+    // dead connection shows up on the socket itself.
+    static void expireRequests(PoolSession& session) {
+        auto now = std::chrono::steady_clock::now();
+        auto timeout = std::chrono::seconds(REQUEST_TIMEOUT_SECONDS);
+        for (auto it = session.pending.begin(); it != session.pending.end();) {
+            PendingRequest& request = it->second;
+            if (now - request.sentAt < timeout) {
+                ++it;
+                continue;
+            }
+            if (request.kind == PendingRequest::LOGIN) {
+                failSession(session, "no login response received");
+                return;
+            }
+            std::string jobId;
+            size_t pool = 0;
+            if (request.kind == PendingRequest::SUBMIT && request.attempts < SUBMIT_ATTEMPTS &&
+                jobForGeneration(request.generation, jobId, pool) && jobId == request.jobId && pool == session.index) {
+                Utils::threadSafePrint("No reply to share " + request.nonceHex + " after " +
+                                       std::to_string(REQUEST_TIMEOUT_SECONDS) + " s - resubmitting", true);
+                request.attempts++;
+                request.sentAt = now;
+                if (!sendRequest(session, request.payload)) {
+                    failSession(session, "send failed");
+                    return;
+                }
+                ++it;
+                continue;
+            }
+            if (request.kind == PendingRequest::SUBMIT) {
+                Utils::threadSafePrint("Share " + request.nonceHex + " (J: " + request.jobId + ") got no reply - dropped", true);
+            } else if (config.debugMode) {
+                Utils::threadSafePrint("[POOL] " + session.name() + " did not answer request " + std::to_string(it->first), true);
+            }
+            it = session.pending.erase(it);
+        }
     }
 
-    std::string receiveData(socket_t socket) {
-        if (socket == INVALID_SOCKET_VALUE) {
-            Utils::threadSafePrint("Invalid socket", true);
-            return "";
+    // A job switch that blocked the loop (a dataset rebuilt in place, threads
+    // released) delays every reply behind it. Restart the clocks of what is
+    // in flight so it neither times out nor skews the pools' RTT.
+    static void discountStall(Clock::time_point started) {
+        auto now = Clock::now();
+        if (now - started < std::chrono::milliseconds(50)) {  // A normal publish takes microseconds
+            return;
         }
-
-        char buffer[4096];
-        std::string messageBuffer;
-        
-        fd_set readfds;
-        FD_ZERO(&readfds);
-        FD_SET(socket, &readfds);
-        struct timeval tv = { 1, 0 };
-        
-        int status = select(select_nfds(socket), &readfds, nullptr, nullptr, &tv);
-        if (status <= 0) {
-            if (status == 0) return "";
-            if (GET_SOCKET_ERROR() == WOULD_BLOCK) return "";
-            Utils::threadSafePrint("select failed: " + std::to_string(GET_SOCKET_ERROR()), true);
-            return "";
-        }
-
-        int bytesReceived = recv(socket, buffer, sizeof(buffer) - 1, 0);
-        if (bytesReceived <= 0) {
-            if (bytesReceived == 0) {
-                Utils::threadSafePrint("Connection closed by pool", true);
-            } else if (GET_SOCKET_ERROR() == WOULD_BLOCK) {
-                return "";
-            } else {
-                Utils::threadSafePrint("Error receiving data: " + std::to_string(GET_SOCKET_ERROR()), true);
+        for (auto& session : sessions) {
+            for (auto& entry : session->pending) {
+                entry.second.sentAt = now;
+                entry.second.stalled = true;
+            }
+            if (session->state == PoolSession::CONNECTING) {
+                session->stateSince = now;
             }
-            return "";
         }
-        buffer[bytesReceived] = '\0';
-        messageBuffer += buffer;
+    }
 
-        size_t pos = 0;
-        while ((pos = messageBuffer.find('\n')) != std::string::npos) {
-            std::string message = messageBuffer.substr(0, pos);
-            messageBuffer = messageBuffer.substr(pos + 1);
-            if (message.empty()) continue;
-            if (!message.empty() && message.back() == '\r') message.pop_back();
-            return message;
+    // Write as much of the session's tx buffer as the socket takes; the rest
+    // goes out when the loop reports the socket writable again. False on a
+    // socket error.
+    static bool flushPending(PoolSession& session) {
+        while (!session.tx.empty()) {
+            int sent = send(session.socket, session.tx.data(), static_cast<int>(session.tx.size()), SEND_NO_SIGNAL);
+            if (sent == SOCKET_ERROR_VALUE) {
+                if (GET_SOCKET_ERROR() == WOULD_BLOCK) {
+                    networkLoop.setWriteInterest(session.socket, true);
+                    return true;
+                }
+                Utils::threadSafePrint("send failed: " + std::to_string(GET_SOCKET_ERROR()), true);
+                return false;
+            }
+            session.tx.erase(0, static_cast<size_t>(sent));
         }
-        return "";
+        networkLoop.setWriteInterest(session.socket, false);
+        return true;
     }
 
-    bool initialize() {
-        poolSocket = INVALID_SOCKET_VALUE;
-        shouldStop = false;
-        currentSeedHash.clear();
-        sessionId.clear();
-        currentTargetHex.clear();
-        
-        if (!Platform::initializeSockets()) {
-            Utils::threadSafePrint("Failed to initialize sockets", true);
+    // sendRequest: queue newline-terminated JSON and send what fits now
+    static bool sendRequest(PoolSession& session, const std::string& request) {
+        if (session.socket == INVALID_SOCKET_VALUE) {
+            Utils::threadSafePrint("Cannot send: Invalid socket", true);
             return false;
         }
-        Utils::threadSafePrint("Sockets initialized successfully", true);
-        return true;
+
+        session.tx += request;
+        session.tx += '\n';
+        return flushPending(session);
     }
 
-    bool connect() {
-        if (config.poolAddress.empty() || config.poolPort == 0) {
-            Utils::threadSafePrint("Invalid pool configuration", true);
+    // Drop the connection and everything tied to it: buffered bytes, unanswered
+    // requests, its last job and the job ids it published (shares for them are
+    // discarded). Health counters are kept.
+    static void closeSession(PoolSession& session) {
+        if (session.socket != INVALID_SOCKET_VALUE) {
+            networkLoop.unwatch(session.socket);
+            CLOSE_SOCKET(session.socket);
+            session.socket = INVALID_SOCKET_VALUE;
+        }
+        session.state = PoolSession::CLOSED;
+        session.stateSince = Clock::now();
+        session.sessionId.clear();
+        session.rx.clear();
+        session.tx.clear();
+        session.hasJob = false;
+        if (!session.pending.empty()) {
+            Utils::threadSafePrint("Dropping " + std::to_string(session.pending.size()) + " unanswered request(s)", true);
+            session.pending.clear();
+        }
+        if (active == &session) {
+            active = nullptr;
+        }
+        std::lock_guard<std::mutex> lock(jobMutex);
+        recentJobIds.erase(std::remove_if(recentJobIds.begin(), recentJobIds.end(),
+                                          [&session](const RecentJob& entry) { return entry.pool == session.index; }),
+                           recentJobIds.end());
+    }
+
+    // A connect, login or established connection failed: close it and back
+    // off before trying this pool again (1, 2, 4 ... RECONNECT_MAX_SECONDS)
+    static void failSession(PoolSession& session, const std::string& reason) {
+        bool wasActive = &session == active;
+        closeSession(session);
+        session.failures++;
+        int delay = (std::min)(1 << (std::min)(session.failures - 1, 6), RECONNECT_MAX_SECONDS);
+        session.retryAt = Clock::now() + std::chrono::seconds(delay);
+        Utils::threadSafePrint("Pool " + session.name() + ": " + reason +
+                               (wasActive ? " - failing over" : "") +
+                               " (next attempt in " + std::to_string(delay) + " s)", true);
+    }
+
+    static bool sendLogin(PoolSession& session) {
+        uint64_t requestId = jsonRpcId.fetch_add(1);
+        picojson::object loginObj;
+        loginObj["id"] = picojson::value(static_cast<double>(requestId));
+        loginObj["jsonrpc"] = picojson::value("2.0");
+        loginObj["method"] = picojson::value("login");
+        loginObj["params"] = picojson::value(loginParams);
+
+        PendingRequest request;
+        request.kind = PendingRequest::LOGIN;
+        request.payload = picojson::value(loginObj).serialize();
+        request.generation = 0;
+        if (config.debugMode) {
+            Utils::threadSafePrint("[POOL TX] " + request.payload, true);
+        }
+        return sendTracked(session, requestId, std::move(request));
+    }
+
+    // Ask for the current job, for a session promoted before it sent one
+    static bool sendGetJob(PoolSession& session) {
+        uint64_t requestId = jsonRpcId.fetch_add(1);
+        picojson::object request;
+        request["id"] = picojson::value(static_cast<double>(requestId));
+        request["jsonrpc"] = picojson::value("2.0");
+        request["method"] = picojson::value("getjob");
+
+        picojson::object params;
+        params["id"] = picojson::value(session.sessionId);
+        request["params"] = picojson::value(params);
+
+        PendingRequest pending;
+        pending.kind = PendingRequest::GETJOB;
+        pending.payload = picojson::value(request).serialize();
+        pending.generation = 0;
+        return sendTracked(session, requestId, std::move(pending));
+    }
+
+    static bool sendKeepalive(PoolSession& session) {
+        static int keepaliveCount = 0;
+        keepaliveCount++;
+
+        // Shares the JSON-RPC id space so its reply never matches a submit
+        uint64_t requestId = jsonRpcId.fetch_add(1);
+        picojson::object request;
+        request["id"] = picojson::value(static_cast<double>(requestId));
+        request["jsonrpc"] = picojson::value("2.0");
+        request["method"] = picojson::value("keepalived");
+
+        picojson::object params;
+        params["id"] = picojson::value(session.sessionId);
+        request["params"] = picojson::value(params);
+
+        PendingRequest pending;
+        pending.kind = PendingRequest::KEEPALIVE;
+        pending.payload = picojson::value(request).serialize();
+        pending.generation = 0;
+        if (config.debugMode) {
+            Utils::threadSafePrint("[POOL TX] " + pending.payload, true);
+        }
+
+        // sendRequest adds the newline; a failure is handled as a lost connection
+        if (!sendTracked(session, requestId, std::move(pending))) {
             return false;
         }
-        
-        std::string fullAddress = config.poolAddress + ":" + std::to_string(config.poolPort);
-        Utils::threadSafePrint("Connecting to " + fullAddress, true);
-        
-        // Resolve hostname
+
+        if (config.debugMode) {
+            Utils::threadSafePrint("[KEEPALIVE #" + std::to_string(keepaliveCount) + "] Sent to " + session.name(), true);
+        }
+        return true;
+    }
+
+    // Start a non-blocking connect; the loop reports it done as writable.
+    // Name resolution still blocks, once per attempt.
+    static bool startConnect(PoolSession& session) {
+        Utils::threadSafePrint("Connecting to " + session.name(), true);
+
         struct addrinfo hints = {}, *result = nullptr;
         hints.ai_family = AF_INET;
         hints.ai_socktype = SOCK_STREAM;
         hints.ai_protocol = IPPROTO_TCP;
-        
-        std::string portStr = std::to_string(config.poolPort);
-        int res = getaddrinfo(config.poolAddress.c_str(), portStr.c_str(), &hints, &result);
-        
-        if (res != 0) {
-            Utils::threadSafePrint("Failed to resolve hostname: " + config.poolAddress, true);
+
+        std::string portStr = std::to_string(session.endpoint.port);
+        if (getaddrinfo(session.endpoint.host.c_str(), portStr.c_str(), &hints, &result) != 0) {
+            failSession(session, "failed to resolve hostname");
             return false;
         }
-        
-        // Create socket
-        poolSocket = socket(result->ai_family, result->ai_socktype, result->ai_protocol);
-        if (poolSocket == INVALID_SOCKET_VALUE) {
-            Utils::threadSafePrint("Failed to create socket: " + std::to_string(GET_SOCKET_ERROR()), true);
+
+        session.socket = socket(result->ai_family, result->ai_socktype, result->ai_protocol);
+        if (session.socket == INVALID_SOCKET_VALUE) {
             freeaddrinfo(result);
+            failSession(session, "failed to create socket: " + std::to_string(GET_SOCKET_ERROR()));
             return false;
         }
-        
-        // Connect
-        if (::connect(poolSocket, result->ai_addr, static_cast<int>(result->ai_addrlen)) == SOCKET_ERROR_VALUE) {
-            Utils::threadSafePrint("Failed to connect to pool: " + std::to_string(GET_SOCKET_ERROR()), true);
-            CLOSE_SOCKET(poolSocket);
-            poolSocket = INVALID_SOCKET_VALUE;
+        if (!Platform::setSocketNonBlocking(session.socket)) {
             freeaddrinfo(result);
+            failSession(session, "failed to make the socket non-blocking");
+            return false;
+        }
+
+        if (::connect(session.socket, result->ai_addr, static_cast<int>(result->ai_addrlen)) == SOCKET_ERROR_VALUE &&
+            GET_SOCKET_ERROR() != CONNECT_IN_PROGRESS) {
+            int error = GET_SOCKET_ERROR();
+            freeaddrinfo(result);
+            failSession(session, "failed to connect: " + std::to_string(error));
             return false;
         }
-        
         freeaddrinfo(result);
-        Utils::threadSafePrint("Connected to pool", true);
+
+        if (!networkLoop.watch(session.socket, true)) {
+            failSession(session, "failed to watch the socket");
+            return false;
+        }
+        session.state = PoolSession::CONNECTING;
+        session.stateSince = Clock::now();
         return true;
     }
 
-    bool login(const std::string& wallet, const std::string& password, 
-               const std::string& workerName, const std::string& userAgent) {
+    // The connect finished, one way or the other: log in if it worked
+    static void finishConnect(PoolSession& session) {
+        int error = 0;
+        socklen_t length = sizeof(error);
+        if (getsockopt(session.socket, SOL_SOCKET, SO_ERROR, reinterpret_cast<char*>(&error), &length) != 0) {
+            error = GET_SOCKET_ERROR();
+        }
+        if (error != 0) {
+            failSession(session, "failed to connect: " + std::to_string(error));
+            return;
+        }
+        networkLoop.setWriteInterest(session.socket, false);
+        session.state = PoolSession::LOGGING_IN;
+        session.stateSince = Clock::now();
+        if (!sendLogin(session)) {
+            failSession(session, "send failed");
+        }
+    }
+
+    void cleanup() {
+        for (auto& session : sessions) {
+            closeSession(*session);
+        }
+        sessions.clear();
+        active = nullptr;
+        networkLoop.close();
+        Platform::cleanupSockets();
+    }
+
+    // One line from a pool: a job notification or the reply to a request
+    static void handleMessage(PoolSession& session, std::string_view message) {
+        Stratum::JobFields job;
+        if (Stratum::parseJobNotification(message, job)) {
+            deliverJob(session, job);
+            return;
+        }
+
         try {
-            jsonRpcId++;
-            
-            picojson::object loginObj;
-            loginObj["id"] = picojson::value(static_cast<double>(jsonRpcId.load()));
-            loginObj["jsonrpc"] = picojson::value("2.0");
-            loginObj["method"] = picojson::value("login");
-            
-            picojson::object params;
-            
-            // FIX: Format login with worker name appended
-            std::string loginString = wallet;
-            if (!workerName.empty() && workerName != "x") {
-                loginString = wallet + "." + workerName;
-            }
-            params["login"] = picojson::value(loginString);
-            
-            params["pass"] = picojson::value(password);
-            params["agent"] = picojson::value(userAgent);
-            
-            if (!workerName.empty()) {
-                params["rigid"] = picojson::value(workerName);
-            }
-            
-            loginObj["params"] = picojson::value(params);
-            
-            std::string loginJson = picojson::value(loginObj).serialize();
-            
-            Utils::threadSafePrint("Sending login request", true);
-            
-            // Use sendAndReceive which handles both send and receive
-            std::string response = sendAndReceive(loginJson);
-            if (response.empty()) {
-                Utils::threadSafePrint("No login response received", true);
-                return false;
-            }
-            
-            Utils::threadSafePrint("Received login response", true);
-            
             picojson::value v;
-            std::string err = picojson::parse(v, response);
-            if (!err.empty() || !v.is<picojson::object>()) {
-                Utils::threadSafePrint("Failed to parse login response", true);
-                return false;
+            std::string err;
+            picojson::parse(v, message.begin(), message.end(), &err);
+
+            if (err.empty() && v.is<picojson::object>()) {
+                const picojson::object& obj = v.get<picojson::object>();
+
+                // Check if this is a new job - just process it
+                if (obj.find("method") != obj.end()) {
+                    std::string method = obj.at("method").get<std::string>();
+
+                    if (method == "job") {
+                        if (obj.find("params") != obj.end() && obj.at("params").is<picojson::object>() &&
+                            jobFromObject(obj.at("params").get<picojson::object>(), job)) {
+                            deliverJob(session, job);
+                        }
+                    }
+                }
+                // Reply to one of our requests, matched by id
+                else if (obj.find("id") != obj.end() && obj.at("id").is<double>()) {
+                    uint64_t requestId = static_cast<uint64_t>(obj.at("id").get<double>());
+                    if (!processReply(session, requestId, obj) && config.debugMode) {
+                        Utils::threadSafePrint("[POOL] Reply to unknown request " + std::to_string(requestId), true);
+                    }
+                }
             }
-            
-            const picojson::object& obj = v.get<picojson::object>();
-            
-            if (obj.find("result") != obj.end() && obj.at("result").is<picojson::object>()) {
-                const picojson::object& result = obj.at("result").get<picojson::object>();
-                
-                if (result.find("id") != result.end()) {
-                    sessionId = result.at("id").get<std::string>();
-                    Utils::threadSafePrint("Session ID: " + sessionId, true);
+        } catch (const std::exception& e) {
+            if (config.debugMode) {
+                Utils::threadSafePrint("[POOL] Parse error: " + std::string(e.what()), true);
+            }
+        }
+    }
+
+    // Read everything the socket has, handling each complete line. Fails
+    // the session once the pool closed the connection or it broke.
+    static void readSession(PoolSession& session) {
+        while (session.state != PoolSession::CLOSED) {
+            // Lines are handled after every recv, so a burst of messages
+            // never needs more room than one line
+            size_t room = session.rx.writable();
+            if (room == 0) {
+                failSession(session, "sent a line longer than " + std::to_string(LineBuffer::CAPACITY) + " bytes");
+                return;
+            }
+            char* target = session.rx.writePtr();
+            int bytesReceived = recv(session.socket, target, static_cast<int>(room), 0);
+            if (bytesReceived > 0) {
+                if (config.debugMode) {
+                    Utils::threadSafePrint("[POOL RX] " + std::string(target, static_cast<size_t>(bytesReceived)), true);
                 }
-                
-                if (result.find("job") != result.end() && result.at("job").is<picojson::object>()) {
-                    const picojson::object& jobObj = result.at("job").get<picojson::object>();
-                    processNewJob(jobObj);
+                session.rx.commit(static_cast<size_t>(bytesReceived));
+                std::string_view message;
+                while (session.state != PoolSession::CLOSED && session.rx.nextLine(message)) {
+                    handleMessage(session, message);
                 }
-                
-                if (!config.debugMode) {
-                    Utils::threadSafePrint("Successfully logged in to pool", true);
-                    Utils::threadSafePrint("Worker: " + loginString, true);
+                continue;
+            }
+            if (bytesReceived == SOCKET_ERROR_VALUE && GET_SOCKET_ERROR() == WOULD_BLOCK) {
+                return;
+            }
+            failSession(session, bytesReceived == 0 ? std::string("connection closed")
+                                                    : "receive failed: " + std::to_string(GET_SOCKET_ERROR()));
+            return;
+        }
+    }
+
+    // Lower is better: the moving-average round trip, inflated by the share
+    // of submits rejected as stale. Unmeasured pools count as slow.
+    static double score(const PoolSession& session) {
+        double rttMs = session.rttMs > 0 ? session.rttMs : 1000.0;
+        uint64_t answered = session.accepted + session.rejected;
+        double staleRate = answered > 0 ? static_cast<double>(session.stale) / static_cast<double>(answered) : 0.0;
+        return rttMs * (1.0 + 4.0 * staleRate);
+    }
+
+    // Mine this pool's jobs from now on. A standby already holds its latest
+    // job, so failing over to it publishes without waiting on the network.
+    static void promote(PoolSession& session, const std::string& reason) {
+        active = &session;
+        activeSince = Clock::now();
+        Utils::threadSafePrint("Mining on pool " + session.name() + " (" + reason + ")", true);
+        if (session.hasJob) {
+            processJob(session.latestJob.fields(), session.index);
+        } else if (!sendGetJob(session)) {
+            failSession(session, "send failed");
+        }
+    }
+
+    // Pool selection, run every loop turn: time out connects, fail over,
+    // keep exactly one standby logged in, probe pools that are down, and
+    // move to the standby when it has been clearly faster
+    static void maintainPools() {
+        auto now = Clock::now();
+        for (auto& session : sessions) {
+            if (session->state == PoolSession::CONNECTING &&
+                now - session->stateSince >= std::chrono::seconds(CONNECT_TIMEOUT_SECONDS)) {
+                failSession(*session, "connect timed out");
+            }
+        }
+
+        auto bestStandby = [] {
+            PoolSession* best = nullptr;
+            for (auto& session : sessions) {
+                if (session->state == PoolSession::READY && session.get() != active &&
+                    (best == nullptr || score(*session) < score(*best))) {
+                    best = session.get();
                 }
-                
-                return true;
             }
-            
-            if (obj.find("error") != obj.end() && !obj.at("error").is<picojson::null>()) {
-                const picojson::object& error = obj.at("error").get<picojson::object>();
-                std::string errorMsg = "Unknown error";
-                if (error.find("message") != error.end()) {
-                    errorMsg = error.at("message").get<std::string>();
+            return best;
+        };
+
+        PoolSession* standby = bestStandby();
+        if (active == nullptr && standby != nullptr) {
+            promote(*standby, activeSince == Clock::time_point() ? "connected" : "failover");
+            standby = bestStandby();
+        }
+
+        // Extra logged-in pools only cost keepalives; close them once their
+        // replies are in
+        bool connecting = false;
+        for (auto& session : sessions) {
+            if (session->state == PoolSession::READY && session.get() != active && session.get() != standby &&
+                session->pending.empty()) {
+                closeSession(*session);
+                session->retryAt = now;
+            }
+            if (session->state == PoolSession::CONNECTING || session->state == PoolSession::LOGGING_IN) {
+                connecting = true;
+            }
+        }
+
+        if (active == nullptr || (standby == nullptr && !connecting) ||
+            now - lastProbe >= std::chrono::seconds(PROBE_INTERVAL_SECONDS)) {
+            bool probed = false;
+            for (auto& session : sessions) {
+                if (session->state == PoolSession::CLOSED && now >= session->retryAt) {
+                    startConnect(*session);
+                    probed = true;
                 }
-                Utils::threadSafePrint("Login error: " + errorMsg, true);
-                return false;
             }
-            
-            Utils::threadSafePrint("Unexpected login response format", true);
-            return false;
+            if (probed) {
+                lastProbe = now;
+            }
         }
-        catch (const std::exception& e) {
-            Utils::threadSafePrint("Login exception: " + std::string(e.what()), true);
-            return false;
+
+        if (active != nullptr && standby != nullptr && standby->hasJob &&
+            now - activeSince >= std::chrono::seconds(SELECT_INTERVAL_SECONDS) &&
+            score(*standby) < score(*active) * SWITCH_MARGIN) {
+            std::stringstream reason;
+            reason << std::fixed << std::setprecision(1) << "faster: " << standby->rttMs << " ms vs "
+                   << active->rttMs << " ms";
+            promote(*standby, reason.str());
         }
     }
 
-    void cleanup() {
-        if (poolSocket != INVALID_SOCKET_VALUE) {
-            CLOSE_SOCKET(poolSocket);
-            poolSocket = INVALID_SOCKET_VALUE;
+    static int millisecondsUntil(std::chrono::steady_clock::time_point when) {
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(when - std::chrono::steady_clock::now()).count();
+        return static_cast<int>((std::max)(static_cast<decltype(ms)>(0), ms));
+    }
+
+    // Earliest timer still ahead: connect and request timeouts, keepalives,
+    // retries and pool selection
+    static Clock::time_point nextTimer(Clock::time_point now) {
+        Clock::time_point next = now + std::chrono::seconds(KEEPALIVE_SECONDS);
+        auto consider = [&](Clock::time_point when) {
+            if (when > now && when < next) next = when;
+        };
+        for (auto& session : sessions) {
+            if (session->state == PoolSession::CONNECTING) {
+                consider(session->stateSince + std::chrono::seconds(CONNECT_TIMEOUT_SECONDS));
+            } else if (session->state == PoolSession::READY) {
+                consider(session->nextKeepalive);
+            } else if (session->state == PoolSession::CLOSED) {
+                consider(session->retryAt);
+            }
+            for (const auto& entry : session->pending) {
+                consider(entry.second.sentAt + std::chrono::seconds(REQUEST_TIMEOUT_SECONDS));
+            }
         }
-        Platform::cleanupSockets();
+        if (active != nullptr) {
+            consider(activeSince + std::chrono::seconds(SELECT_INTERVAL_SECONDS));
+        }
+        consider(lastProbe + std::chrono::seconds(PROBE_INTERVAL_SECONDS));
+        return next;
     }
 
-    void jobListener() {
-        auto lastKeepalive = std::chrono::steady_clock::now();
-        std::string buffer;
-
-        while (!shouldStop) {
-            // Non-blocking receive with timeout
-            fd_set readSet;
-            FD_ZERO(&readSet);
-            FD_SET(poolSocket, &readSet);
-            
-            struct timeval timeout;
-            timeout.tv_sec = 0;
-            timeout.tv_usec = 100000; // 100ms
-
-            int nfds = select_nfds(poolSocket);
-            int result = select(nfds, &readSet, nullptr, nullptr, &timeout);
-            
-            if (result > 0 && FD_ISSET(poolSocket, &readSet)) {
-                char chunk[4096];
-                int bytesReceived = recv(poolSocket, chunk, sizeof(chunk) - 1, 0);
-                
-                if (bytesReceived > 0) {
-                    chunk[bytesReceived] = '\0';
-                    buffer += chunk;
-                    
-                    if (config.debugMode) {
-                        Utils::threadSafePrint("[POOL RX] " + std::string(chunk), true);
-                    }
-                    
-                    // Process complete JSON messages (line-delimited)
-                    size_t pos = 0;
-                    while ((pos = buffer.find('\n')) != std::string::npos) {
-                        std::string message = buffer.substr(0, pos);
-                        buffer.erase(0, pos + 1);
-                        
-                        // Remove carriage return if present
-                        if (!message.empty() && message.back() == '\r') {
-                            message.pop_back();
-                        }
-                        
-                        if (message.empty()) continue;
-                        
-                        try {
-                            picojson::value v;
-                            std::string err = picojson::parse(v, message);
-                            
-                            if (err.empty() && v.is<picojson::object>()) {
-                                const picojson::object& obj = v.get<picojson::object>();
-                                
-                                // Check if this is a new job - just process it
-                                if (obj.find("method") != obj.end()) {
-                                    std::string method = obj.at("method").get<std::string>();
-                                    
-                                    if (method == "job") {
-                                        if (obj.find("params") != obj.end() && obj.at("params").is<picojson::object>()) {
-                                            const picojson::object& params = obj.at("params").get<picojson::object>();
-                                            processNewJob(params);
-                                        }
-                                    }
-                                }
-                                // Check for async error responses (delayed rejections)
-                                else if (obj.find("error") != obj.end() && !obj.at("error").is<picojson::null>()) {
-                                    std::string errorMsg = "Unknown error";
-                                    const picojson::value& errorVal = obj.at("error");
-                                    
-                                    if (errorVal.is<picojson::object>()) {
-                                        const picojson::object& errorObj = errorVal.get<picojson::object>();
-                                        if (errorObj.find("message") != errorObj.end()) {
-                                            errorMsg = errorObj.at("message").get<std::string>();
-                                        }
-                                    } else if (errorVal.is<std::string>()) {
-                                        errorMsg = errorVal.get<std::string>();
-                                    }
-                                    
-                                    // Undo optimistic acceptance if any
-                                    MiningStatsUtil::acceptedShares--;
-                                    MiningStatsUtil::rejectedShares++;
-                                    Utils::threadSafePrint("Share REJECTED (async): " + errorMsg + 
-                                        " (Accepted: " + std::to_string(MiningStatsUtil::acceptedShares.load()) +
-                                        ", Rejected: " + std::to_string(MiningStatsUtil::rejectedShares.load()) + ")", true);
-                                }
-                            }
-                        } catch (const std::exception& e) {
-                            if (config.debugMode) {
-                                Utils::threadSafePrint("[POOL] Parse error: " + std::string(e.what()), true);
-                            }
-                        }
-                    }
-                } else if (bytesReceived == 0) {
-                    Utils::threadSafePrint("Pool connection closed", true);
-                    break;
+    // One turn of the reactor: sleep until a socket, a wake() or the next
+    // timer, then do everything that is due
+    static void pollNetwork() {
+        // Finished background builds and threads moving on are not
+        // signalled, so poll while either is awaited
+        int timeoutMs = millisecondsUntil(nextTimer(Clock::now()));
+        if (RandomXManager::isStandbyBuilding() || waitingForThreads()) {
+            timeoutMs = (std::min)(timeoutMs, STANDBY_POLL_MS);
+        }
+        networkLoop.wait(timeoutMs);
+
+        for (auto& entry : sessions) {
+            PoolSession& session = *entry;
+            if (session.socket == INVALID_SOCKET_VALUE) {
+                continue;
+            }
+            unsigned events = networkLoop.events(session.socket);
+            if (session.state == PoolSession::CONNECTING) {
+                if (events != EventLoop::NONE) {
+                    finishConnect(session);
                 }
+                continue;
+            }
+            if ((events & EventLoop::WRITABLE) && !flushPending(session)) {
+                failSession(session, "send failed");
+                continue;
             }
-            
-            // Send keepalive every 30 seconds
-            auto now = std::chrono::steady_clock::now();
-            auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(now - lastKeepalive).count();
-            
-            if (elapsed >= 30) {
-                sendKeepalive();
-                lastKeepalive = now;
+            if (events & (EventLoop::READABLE | EventLoop::HANGUP)) {
+                readSession(session);
             }
-            
-            std::this_thread::sleep_for(std::chrono::milliseconds(50));
         }
-    }
 
-    void processNewJob(const picojson::object& jobData) {
-        try {
-            std::string blobStr = jobData.at("blob").get<std::string>();
-            std::string jobId = jobData.at("job_id").get<std::string>();
-            std::string target = jobData.at("target").get<std::string>();
-            uint64_t height = static_cast<uint64_t>(jobData.at("height").get<double>());
-            std::string seedHash = jobData.at("seed_hash").get<std::string>();
-
-            if (!RandomXManager::setTargetAndDifficulty(target)) {
-                Utils::threadSafePrint("Failed to set target", true);
-                return;
+        auto now = Clock::now();
+        for (auto& entry : sessions) {
+            PoolSession& session = *entry;
+            if (session.state == PoolSession::READY && now >= session.nextKeepalive) {
+                session.nextKeepalive = now + std::chrono::seconds(KEEPALIVE_SECONDS);
+                if (!sendKeepalive(session)) {
+                    failSession(session, "failed to send keepalive");
+                    continue;
+                }
+            }
+            if (session.state != PoolSession::CLOSED) {
+                expireRequests(session);
             }
+        }
 
-            Job job(blobStr, jobId, target, height, seedHash);
-            distributeJob(job);
+        submitQueuedShares();
+        maintainPools();
+    }
+
+    bool initialize() {
+        for (auto& session : sessions) {
+            closeSession(*session);
         }
-        catch (const std::exception& e) {
-            Utils::threadSafePrint("Error processing job: " + std::string(e.what()), true);
+        sessions.clear();
+        active = nullptr;
+        activeSince = Clock::time_point();
+        lastProbe = Clock::time_point();
+        shouldStop = false;
+        currentSeedHash.clear();
+        currentTargetHex.clear();
+        std::atomic_store(&publishedJob, std::shared_ptr<const Job>());
+        {
+            std::lock_guard<std::mutex> lock(jobMutex);
+            recentJobIds.clear();
+            deferredJob.reset();
+            parkedGeneration = retiredGeneration = 0;
         }
+
+        if (!Platform::initializeSockets()) {
+            Utils::threadSafePrint("Failed to initialize sockets", true);
+            return false;
+        }
+        Utils::threadSafePrint("Sockets initialized successfully", true);
+        return true;
     }
 
-    void handleSeedHashChange(const std::string& newSeedHash) {
-        if (newSeedHash.empty()) return;
-        if (currentSeedHash != newSeedHash) {
-            currentSeedHash = newSeedHash;
-            RandomXManager::handleSeedHashChange(newSeedHash);
+    bool connect() {
+        std::vector<PoolEndpoint> pools = config.getPools();
+        if (pools.front().host.empty() || pools.front().port == 0) {
+            Utils::threadSafePrint("Invalid pool configuration", true);
+            return false;
         }
+        if (!networkLoop.open()) {
+            Utils::threadSafePrint("Failed to create the network event loop", true);
+            return false;
+        }
+
+        for (size_t i = 0; i < pools.size(); i++) {
+            auto session = std::make_unique<PoolSession>();
+            session->index = i;
+            session->endpoint = pools[i];
+            sessions.push_back(std::move(session));
+        }
+
+        // All at once: whichever logs in first is mined, the next one
+        // becomes the standby
+        bool started = false;
+        for (auto& session : sessions) {
+            if (startConnect(*session)) {
+                started = true;
+            }
+        }
+        lastProbe = Clock::now();
+        return started;
     }
 
-    std::string sendAndReceive(const std::string& payload) {
-        if (poolSocket == INVALID_SOCKET_VALUE) return "";
+    bool login(const std::string& wallet, const std::string& password,
+               const std::string& workerName, const std::string& userAgent) {
+        // FIX: Format login with worker name appended
+        std::string loginString = wallet;
+        if (!workerName.empty() && workerName != "x") {
+            loginString = wallet + "." + workerName;
+        }
+        loginParams.clear();
+        loginParams["login"] = picojson::value(loginString);
+        loginParams["pass"] = picojson::value(password);
+        loginParams["agent"] = picojson::value(userAgent);
+        if (!workerName.empty()) {
+            loginParams["rigid"] = picojson::value(workerName);
+        }
 
-        std::string fullPayload = payload + "\n";
-        int bytesSent = send(poolSocket, fullPayload.c_str(), static_cast<int>(fullPayload.length()), 0);
-        if (bytesSent == SOCKET_ERROR_VALUE) return "";
+        // Run the loop here until a pool is mined, or every pool failed its
+        // first attempt; the network thread takes over from there
+        auto deadline = Clock::now() + std::chrono::seconds(CONNECT_TIMEOUT_SECONDS + REQUEST_TIMEOUT_SECONDS);
+        while (active == nullptr && !shouldStop && !::shouldStop && Clock::now() < deadline) {
+            bool attempting = std::any_of(sessions.begin(), sessions.end(), [](const std::unique_ptr<PoolSession>& session) {
+                return session->state != PoolSession::CLOSED;
+            });
+            if (!attempting) {
+                break;
+            }
+            pollNetwork();
+        }
 
-        std::string response;
-        char buffer[4096];
-        
-        fd_set readSet;
-        struct timeval timeout;
-        
-        if (config.debugMode) {
-            Utils::threadSafePrint("[POOL TX] " + payload, true);
+        if (active == nullptr) {
+            Utils::threadSafePrint("Failed to log in to any pool", true);
+            return false;
         }
-        
-        while (true) {
-            FD_ZERO(&readSet);
-            FD_SET(poolSocket, &readSet);
-            timeout.tv_sec = 10;
-            timeout.tv_usec = 0;
+        if (!config.debugMode) {
+            Utils::threadSafePrint("Successfully logged in to pool", true);
+            Utils::threadSafePrint("Worker: " + loginString, true);
+        }
+        return true;
+    }
 
-            int selectResult = select(select_nfds(poolSocket), &readSet, nullptr, nullptr, &timeout);
-            if (selectResult <= 0) break;
+    void jobListener() {
+        while (!shouldStop && !::shouldStop) {
+            pollNetwork();
 
-            int bytesReceived = recv(poolSocket, buffer, sizeof(buffer) - 1, 0);
-            if (bytesReceived <= 0) break;
+            auto started = Clock::now();
+            publishDeferredJob();
+            publishFullModeUpgrade();
+            releaseRetiredWhenIdle();
+            discountStall(started);
+        }
+    }
 
-            buffer[bytesReceived] = '\0';
-            response += buffer;
+    static void processJob(const Stratum::JobFields& fields, size_t pool) {
+        if (!fields.algo.empty() && fields.algo != "rx/0") {
+            Utils::threadSafePrint("Pool sent a job for algo " + std::string(fields.algo) + "; only rx/0 is supported", true);
+        }
+        if (!RandomXManager::setTargetAndDifficulty(std::string(fields.target))) {
+            Utils::threadSafePrint("Failed to set target", true);
+            return;
+        }
 
-            if (response.find("\n") != std::string::npos) break;
+        Job job(fields.blob, fields.jobId, fields.target, fields.height, fields.seedHash);
+        if (job.getBlobSize() == 0) {
+            Utils::threadSafePrint("Error processing job: malformed blob", true);
+            return;
         }
+        job.pool = pool;
+        auto started = Clock::now();
+        distributeJob(job);
+        discountStall(started);
 
-        while (!response.empty() && (response.back() == '\n' || response.back() == '\r')) {
-            response.pop_back();
+        // Announced ahead of the epoch flip; build its dataset on spare
+        // cycles so the flip is a pointer swap
+        if (!fields.nextSeedHash.empty() && RandomXManager::isDoubleBufferEnabled()) {
+            RandomXManager::prepareSeed(std::string(fields.nextSeedHash));
         }
+    }
 
-        if (config.debugMode && !response.empty()) {
-            Utils::threadSafePrint("[POOL RX] " + response, true);
+    void handleSeedHashChange(const std::string& newSeedHash) {
+        if (newSeedHash.empty()) return;
+        currentSeedHash = newSeedHash;
+        RandomXManager::handleSeedHashChange(newSeedHash);  // Also swaps in a hybrid start's dataset
+    }
+
+    std::shared_ptr<const Job> getCurrentJob() {
+        return std::atomic_load(&publishedJob);
+    }
+
+    // Replace the published snapshot (nullptr parks the mining threads). The
+    // generation is bumped last, so a thread that sees the new generation is
+    // guaranteed to load the new pointer. Caller holds jobMutex.
+    static uint64_t publishSnapshot(std::shared_ptr<Job> snapshot) {
+        uint64_t generation = jobGeneration.load(std::memory_order_relaxed) + 1;
+        if (snapshot) {
+            snapshot->generation = generation;
         }
-        
-        return response;
+        std::atomic_store(&publishedJob, std::shared_ptr<const Job>(std::move(snapshot)));
+        jobGeneration.store(generation, std::memory_order_release);
+        wakeMiningThreads();
+        return generation;
     }
 
-    void sendKeepalive() {
-        static int keepaliveCount = 0;
-        keepaliveCount++;
-        
-        picojson::object request;
-        request["id"] = picojson::value(static_cast<double>(keepaliveCount - 1));
-        request["jsonrpc"] = picojson::value("2.0");
-        request["method"] = picojson::value("keepalived");
-        
-        picojson::object params;
-        params["id"] = picojson::value(sessionId);
-        request["params"] = picojson::value(params);
-        
-        std::string message = picojson::value(request).serialize();
+    void waitForNewJob(uint64_t seenGeneration) {
+        std::unique_lock<std::mutex> lock(jobWakeMutex);
+        // Publishers always notify; the timeout only bounds a missed shutdown
+        jobWakeCondition.wait_for(lock, std::chrono::seconds(1), [seenGeneration] {
+            return ::shouldStop || jobGeneration.load(std::memory_order_acquire) != seenGeneration;
+        });
+    }
+
+    void wakeMiningThreads() {
+        // Taking the mutex orders this against a waiter's predicate check,
+        // so a generation bumped just before it blocks is never missed
+        { std::lock_guard<std::mutex> lock(jobWakeMutex); }
+        jobWakeCondition.notify_all();
+    }
 
-        // Use thread-safe sendRequest (adds newline)
-        if (!sendRequest(message)) {
-            Utils::threadSafePrint("Failed to send keepalive, attempting reconnect", true);
-            // Try to reconnect synchronously (best-effort)
-            if (!reconnect()) {
-                Utils::threadSafePrint("Reconnect attempt failed after keepalive failure", true);
+    // Wait until every mining thread has moved past the given generation,
+    // i.e. nothing still hashes a job (or dataset) from before it. False if
+    // one has not within the timeout (0: just check) - the caller must then
+    // leave the old memory alone and try again later.
+    static bool waitForThreadsToReach(uint64_t generation, std::chrono::milliseconds timeout) {
+        std::vector<MiningThreadData*> threads;
+        {
+            std::lock_guard<std::mutex> lock(threadDataMutex);
+            threads = ::threadData;
+        }
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        for (MiningThreadData* data : threads) {
+            while (data && data->getJobGeneration() < generation) {
+                if (std::chrono::steady_clock::now() >= deadline) {
+                    if (timeout.count() > 0) {
+                        Utils::threadSafePrint("Timed out waiting for thread " +
+                            std::to_string(data->getThreadId()) + " to release its job", true);
+                    }
+                    return false;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
             }
+        }
+        return true;
+    }
+
+    // True while a dataset rebuild or release waits for a straggling thread;
+    // the network loop then polls instead of sleeping until its next timer
+    static bool waitingForThreads() {
+        std::lock_guard<std::mutex> lock(jobMutex);
+        return parkedGeneration != 0 || retiredGeneration != 0;
+    }
+
+    // Free the previous dataset pair of a swap that timed out waiting for the
+    // threads, once the last of them has moved on
+    static void releaseRetiredWhenIdle() {
+        std::lock_guard<std::mutex> lock(jobMutex);
+        if (retiredGeneration == 0 || !waitForThreadsToReach(retiredGeneration, std::chrono::milliseconds(0))) {
             return;
         }
-        
-        if (config.debugMode) {
-            Utils::threadSafePrint("[KEEPALIVE #" + std::to_string(keepaliveCount) + "] Sent", true);
-            Utils::threadSafePrint("[POOL TX] " + message, true);
+        retiredGeneration = 0;
+        Utils::threadSafePrint("All threads left the previous dataset - releasing it", true);
+        RandomXManager::releaseRetired();
+        RandomXManager::refreshReplicas();
+    }
+
+    // Publish the held-back job once its background dataset build is done
+    static void publishDeferredJob() {
+        std::unique_lock<std::mutex> lock(jobMutex);
+        if (!deferredJob || RandomXManager::isStandbyPending(deferredJob->seedHash)) {
+            return;
+        }
+        Job job = *deferredJob;
+        lock.unlock();
+        distributeJob(job);  // Clears deferredJob; only the network thread distributes jobs
+    }
+
+    // Hybrid start: once the current seed's dataset is built, re-publish the
+    // current job so the threads rebind to it. The snapshot keeps its nonce
+    // dispenser, so nothing already hashed in light mode is hashed again.
+    static void publishFullModeUpgrade() {
+        std::shared_ptr<const Job> job = getCurrentJob();
+        if (!job || job->seedHash != RandomXManager::getCurrentSeedHash() ||
+            !RandomXManager::isStandbyReady(job->seedHash)) {
+            return;
         }
+        Job upgraded = *job;
+        upgraded.receivedAt = std::chrono::steady_clock::now();
+        distributeJob(upgraded);
     }
 
     // Add missing distributeJob implementation
     void distributeJob(const Job& job) {
         std::lock_guard<std::mutex> lock(jobMutex);
 
-        // Replace any existing jobs with the new one
-        while (!jobQueue.empty()) jobQueue.pop();
-        jobQueue.push(job);
-
-        // Update seed/hash state and notify worker threads
-        handleSeedHashChange(job.seedHash);
-        jobQueueCondition.notify_all();
-        jobAvailable.notify_all();
+        bool seedChange = !currentSeedHash.empty() && job.seedHash != currentSeedHash;
+        if (seedChange && RandomXManager::isDoubleBufferEnabled()) {
+            // Keep hashing the current job on the current dataset until the
+            // new one is built; only the latest job for the seed is kept
+            RandomXManager::prepareSeed(job.seedHash);
+            if (RandomXManager::isStandbyPending(job.seedHash)) {
+                if (!deferredJob) {
+                    deferredSince = job.receivedAt;
+                    Utils::threadSafePrint("Seed change to " + job.seedHash.substr(0, 16) +
+                        "... - mining continues until the next dataset is ready", true);
+                }
+                deferredJob = std::make_unique<Job>(job);
+                return;
+            }
+        }
+        if (deferredJob && job.seedHash == deferredJob->seedHash) {
+            auto waitedMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - deferredSince).count();
+            Utils::threadSafePrint("Epoch flip waited " + std::to_string(waitedMs) + " ms for the next dataset", true);
+        }
+        deferredJob.reset();  // Superseded, or the pool went back to the current seed
 
-        if (config.debugMode) {
-            Utils::threadSafePrint("Distributed new job: " + job.getJobId(), true);
+        // Without a prebuilt dataset the seed change rebuilds it under the VMs -
+        // park the mining threads on an empty snapshot and wait for them first.
+        // A thread that does not stop in time still reads the dataset, so the
+        // job is held back and retried rather than overwriting it.
+        bool swapStandby = RandomXManager::isStandbyReady(job.seedHash);
+        if (seedChange && !swapStandby) {
+            bool firstAttempt = parkedGeneration == 0;
+            if (firstAttempt) {
+                parkedGeneration = publishSnapshot(nullptr);
+            }
+            if (!waitForThreadsToReach(parkedGeneration, std::chrono::milliseconds(firstAttempt ? THREAD_RELEASE_TIMEOUT_MS : 0))) {
+                if (firstAttempt) {
+                    Utils::threadSafePrint("Dataset rebuild postponed until every thread has stopped hashing", true);
+                }
+                deferredJob = std::make_unique<Job>(job);
+                return;
+            }
         }
-    }
+        parkedGeneration = 0;
 
-    // Add missing reconnect implementation
-    bool reconnect() {
-        Utils::threadSafePrint("Attempting reconnect to pool...", true);
+        // A swap frees the retired pair of the previous one; hold the job back
+        // while a thread may still read that pair
+        if (swapStandby && retiredGeneration != 0) {
+            if (!waitForThreadsToReach(retiredGeneration, std::chrono::milliseconds(0))) {
+                deferredJob = std::make_unique<Job>(job);
+                return;
+            }
+            retiredGeneration = 0;
+            RandomXManager::releaseRetired();
+        }
 
-        // Clean up current connection and try to re-establish
-        cleanup();
+        // Update seed/hash state before any thread can pick up the job
+        handleSeedHashChange(job.seedHash);
 
-        // Try connect, then login
-        if (!connect()) {
-            Utils::threadSafePrint("Reconnect: failed to connect", true);
-            return false;
+        // Each snapshot gets its own nonce space; with --nicehash the top byte
+        // the pool put in the blob is kept and only the low 24 bits are searched
+        auto snapshot = std::make_shared<Job>(job);
+        if (!snapshot->nonces) {  // A re-published snapshot continues its nonce space
+            uint32_t prefix = 0;
+            if (config.nicehash && job.nonceOffset + 4 <= job.getBlobSize()) {
+                prefix = static_cast<uint32_t>(job.getBlobData()[job.nonceOffset + 3]) << 24;
+            }
+            snapshot->nonces = std::make_shared<NonceDispenser>(prefix, config.nicehash ? 8 : 0);
+        }
+        snapshot->datasetGeneration = RandomXManager::getDatasetGeneration();
+        uint64_t generation = publishSnapshot(std::move(snapshot));
+        
+        recentJobIds.push_front(RecentJob{generation, job.jobId, job.pool});
+        if (recentJobIds.size() > RECENT_JOB_COUNT) {
+            recentJobIds.pop_back();
         }
 
-        if (!login(config.walletAddress, config.password, config.workerName, config.userAgent)) {
-            Utils::threadSafePrint("Reconnect: failed to login", true);
-            // leave socket open for caller to inspect / cleanup again
-            return false;
+        // Mining threads were woken by publishSnapshot; this is for startMining
+        jobAvailable.notify_all();
+
+        // After a double-buffered swap the old pair is freed once every thread
+        // has rebound its VM, which happens before it acknowledges the job.
+        // All threads now read the primary dataset, so the NUMA replicas can be
+        // refreshed; threads move back to them with the next job.
+        // If a thread is slow to get there the pair stays allocated and
+        // releaseRetiredWhenIdle() frees it later.
+        if (swapStandby) {
+            if (waitForThreadsToReach(generation, std::chrono::milliseconds(THREAD_RELEASE_TIMEOUT_MS))) {
+                RandomXManager::releaseRetired();
+                RandomXManager::refreshReplicas();
+            } else {
+                retiredGeneration = generation;
+                Utils::threadSafePrint("Keeping the previous dataset until every thread has moved off it", true);
+            }
         }
 
-        Utils::threadSafePrint("Reconnect successful", true);
-        return true;
+        if (config.debugMode) {
+            Utils::threadSafePrint("Distributed new job: " + job.getJobId(), true);
+        }
     }
 }
\ No newline at end of file
@@ -4,7 +4,6 @@
 #include "picojson.h"
 #include "Job.h"
 #include <string>
-#include <queue>
 #include <mutex>
 #include <condition_variable>
 #include <atomic>
@@ -13,43 +12,52 @@
 #include "MiningThreadData.h"
 
 namespace PoolClient {
-    // Use cross-platform socket type
-    extern socket_t poolSocket;
     extern std::mutex jobMutex;
-    extern std::mutex socketMutex;
     extern std::mutex submitMutex;
-    extern std::queue<Job> jobQueue;
     extern std::condition_variable jobAvailable;
-    extern std::condition_variable jobQueueCondition;
     extern std::atomic<bool> shouldStop;
     extern std::string currentSeedHash;
-    extern std::string sessionId;
     extern std::string currentTargetHex;
     extern std::string poolId;
     extern std::vector<std::shared_ptr<MiningThreadData>> threadData;
 
-    // Core networking functions
+    // Current job, published as an immutable refcounted snapshot. Mining
+    // threads compare jobGeneration once per hash and only reload the
+    // snapshot (getCurrentJob) when it has moved - no lock on the hot path.
+    extern std::atomic<uint64_t> jobGeneration;
+    std::shared_ptr<const Job> getCurrentJob();
+
+    // Block an idle mining thread until jobGeneration moves past the one it
+    // has seen (or shutdown). Woken directly by every publish.
+    void waitForNewJob(uint64_t seenGeneration);
+    void wakeMiningThreads();  // Call after setting shouldStop
+
+    // Core networking functions. connect() starts a connection to every
+    // configured pool at once (Config::getPools()); login() logs in on each
+    // and returns once the first is ready, whose jobs are then mined.
     bool initialize();
     bool connect();
     bool login(const std::string& wallet, const std::string& password, 
                const std::string& worker, const std::string& userAgent);
     void cleanup();
 
-    // Job handling
+    // Network thread: a single-threaded reactor (see EventLoop) that owns the
+    // pool sockets after login - it reads jobs and replies, sends submits and
+    // keepalives, and keeps a second pool logged in as a hot standby. When the
+    // active pool drops it fails over to the standby's latest job at once;
+    // otherwise it moves to whichever pool has the best round trip and stale
+    // rate, and reconnects failed pools with exponential backoff.
     void jobListener();
+    void wakeNetworkThread();  // Call after setting shouldStop
     
-    // Share submission
-    bool submitShare(const std::string& jobId, const std::string& nonceHex,
-                    const std::string& hashHex, const std::string& algo);
+    // Share submission: mining threads only enqueue (job generation, nonce,
+    // hash); the job listener thread sends it to the pool the job came from
+    // and matches the pool's reply by JSON-RPC id. Returns false if the
+    // bounded queue is full. Wakes the network thread, so a share goes out
+    // without waiting for a poll.
+    bool queueShare(uint64_t generation, uint32_t nonce, const uint8_t* hash);
     
     // Helper functions
     void handleSeedHashChange(const std::string& newSeedHash);
-    void processNewJob(const picojson::object& jobObj);
-    std::string sendAndReceive(const std::string& payload);
-    std::string receiveData(socket_t sock);
-    std::string sendData(const std::string& data);
     void distributeJob(const Job& job);
-    
-    bool reconnect();
-    void sendKeepalive();
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include "Utils.h"
 #include "Globals.h"
 #include "Platform.h"
+#include "DatasetStore.h"
 #include <fstream>
 #include <vector>
 #include <mutex>
@@ -30,19 +31,17 @@
 #undef min
 #endif
 
-static constexpr size_t MAX_BLOB_SIZE = 128;
-
 // Static member initialization
 int RandomXManager::flags = RANDOMX_FLAG_DEFAULT;
 static int cacheAllocFlags = RANDOMX_FLAG_DEFAULT;
+static int datasetAllocFlags = RANDOMX_FLAG_DEFAULT;  // Full-mode flags, kept while light VMs run
+static bool lightModeSelected = false;  // Decided once, on the first initialize()
 
-std::shared_mutex RandomXManager::vmMutex;
 std::mutex RandomXManager::initMutex;
 std::mutex RandomXManager::hashMutex;
 std::mutex RandomXManager::cacheMutex;
 std::mutex RandomXManager::seedHashMutex;
 std::mutex RandomXManager::targetMutex;
-std::unordered_map<int, randomx_vm*> RandomXManager::vms;
 randomx_cache* RandomXManager::cache = nullptr;
 randomx_dataset* RandomXManager::dataset = nullptr;
 std::string RandomXManager::currentSeedHash;
@@ -51,6 +50,200 @@ bool RandomXManager::useLightMode = false;
 std::vector<uint8_t> RandomXManager::lastHash;
 double RandomXManager::currentDifficulty = 0.0;
 uint256_t RandomXManager::expandedTarget;
+std::atomic<uint64_t> RandomXManager::datasetGeneration{0};
+std::mutex RandomXManager::standbyMutex;
+std::thread RandomXManager::standbyThread;
+std::string RandomXManager::standbySeedHash;
+std::atomic<bool> RandomXManager::standbyBuilding{false};
+std::atomic<bool> RandomXManager::standbyAbort{false};
+std::chrono::steady_clock::time_point RandomXManager::standbyReadyAt;
+std::vector<Platform::NumaNode> RandomXManager::numaNodes;
+std::vector<randomx_dataset*> RandomXManager::replicas;
+std::atomic<bool> RandomXManager::replicasCurrent{false};
+randomx_cache* RandomXManager::standbyCache = nullptr;
+randomx_dataset* RandomXManager::standbyDataset = nullptr;
+randomx_cache* RandomXManager::retiredCache = nullptr;
+randomx_dataset* RandomXManager::retiredDataset = nullptr;
+randomx_cache* RandomXManager::spareCache = nullptr;
+randomx_dataset* RandomXManager::spareDataset = nullptr;
+std::mutex RandomXManager::saveMutex;
+std::thread RandomXManager::saveThread;
+std::atomic<bool> RandomXManager::saveAbort{false};
+
+// --init-threads, else reserve one logical CPU for system responsiveness
+static unsigned int datasetInitThreadCount() {
+    if (config.initThreads > 0) return config.initThreads;
+    unsigned int numThreads = std::thread::hardware_concurrency();
+    if (numThreads == 0) numThreads = 1;
+    if (numThreads > 1) numThreads = (std::max)(1u, numThreads - 1u);
+    return numThreads;
+}
+
+// Hugetlb datasets (2 MiB / 1 GiB pages) are populated inside
+// randomx_alloc_dataset (MAP_POPULATE) on the nodes of the allocating
+// thread's memory policy, and first touch cannot move them afterwards. So the
+// allocation runs under an interleave policy over the target nodes; normal
+// and THP pages are still placed by whoever touches them first.
+static randomx_dataset* allocDatasetOnNodes(int allocFlags, const std::vector<Platform::NumaNode>& nodes) {
+    std::vector<int> nodeIds;
+    for (const auto& node : nodes) nodeIds.push_back(node.id);
+    bool bound = !nodeIds.empty() && Platform::getNumaNodes().size() > 1 &&
+                 Platform::setCurrentThreadMemoryNodes(nodeIds);
+    randomx_dataset* allocated = randomx_alloc_dataset(static_cast<randomx_flags>(allocFlags));
+    if (bound) Platform::setCurrentThreadMemoryNodes({});
+    return allocated;
+}
+
+// Fills every dataset item from the cache. Workers are pinned one per CPU,
+// nodes taken in turn, and take BLOCK_ITEMS blocks from a shared cursor, so a
+// slow or preempted worker only holds up its current block. On multi-node
+// machines each home node's share of the pages is first touched by that
+// node's workers beforehand, so the kernel places it there no matter who
+// computes the items. That only applies to normal and THP pages; hugetlb
+// pages were placed when allocated (allocDatasetOnNodes). With an abort flag the workers give up between blocks
+// once it is set.
+static bool initDatasetItems(randomx_dataset* target, randomx_cache* source, unsigned int numThreads,
+                             const std::atomic<bool>* abort, bool lowPriority,
+                             const std::vector<Platform::NumaNode>& homeNodes) {
+    static constexpr unsigned long BLOCK_ITEMS = 1ul << 13;  // 512 KiB
+    static constexpr size_t PAGE_BYTES = 4096;
+    const unsigned long itemCount = randomx_dataset_item_count();
+
+    std::vector<Platform::NumaNode> nodes = Platform::getNumaNodes();
+    std::vector<unsigned int> cpuOrder;
+    for (size_t i = 0, added = 1; added > 0; i++) {
+        added = 0;
+        for (const auto& node : nodes) {
+            if (i < node.cpus.size()) {
+                cpuOrder.push_back(node.cpus[i]);
+                added++;
+            }
+        }
+    }
+    auto workerCpu = [&cpuOrder](unsigned int worker) {
+        return cpuOrder[worker % cpuOrder.size()];
+    };
+
+    if (nodes.size() > 1 && !homeNodes.empty() && !cpuOrder.empty()) {
+        uint8_t* memory = static_cast<uint8_t*>(randomx_get_dataset_memory(target));
+        const size_t bytes = static_cast<size_t>(itemCount) * RANDOMX_DATASET_ITEM_SIZE;
+        size_t homeCpus = 0;
+        for (const auto& home : homeNodes) homeCpus += home.cpus.size();
+
+        std::vector<std::thread> touchers;
+        size_t offset = 0;
+        for (size_t h = 0; h < homeNodes.size() && homeCpus > 0; h++) {
+            const auto& home = homeNodes[h];
+            size_t share = (h + 1 == homeNodes.size()) ? bytes - offset : bytes / homeCpus * home.cpus.size();
+            std::vector<unsigned int> local;
+            for (unsigned int w = 0; w < (std::min)(numThreads, static_cast<unsigned int>(cpuOrder.size())); w++) {
+                if (std::find(home.cpus.begin(), home.cpus.end(), workerCpu(w)) != home.cpus.end()) {
+                    local.push_back(workerCpu(w));
+                }
+            }
+            // A share without a local worker is left to whoever computes it
+            for (size_t t = 0; t < local.size(); t++) {
+                size_t begin = offset + share / local.size() * t;
+                size_t end = (t + 1 == local.size()) ? offset + share : begin + share / local.size();
+                touchers.emplace_back([memory, begin, end, cpu = local[t]]() {
+                    Platform::pinCurrentThread({cpu});
+                    for (size_t p = (begin + PAGE_BYTES - 1) / PAGE_BYTES * PAGE_BYTES; p < end; p += PAGE_BYTES) {
+                        static_cast<volatile uint8_t*>(memory)[p] = 0;
+                    }
+                });
+            }
+            offset += share;
+        }
+        for (auto& thread : touchers) {
+            thread.join();
+        }
+    }
+
+    std::atomic<unsigned long> cursor{0};
+    std::atomic<unsigned long> done{0};
+    std::atomic<unsigned int> finished{0};
+    std::vector<std::thread> threads;
+    for (unsigned int t = 0; t < numThreads; t++) {
+        threads.emplace_back([&, t]() {
+            if (!cpuOrder.empty()) Platform::pinCurrentThread({workerCpu(t)});
+            if (lowPriority) Platform::lowerCurrentThreadPriority();
+            unsigned long start;
+            while ((start = cursor.fetch_add(BLOCK_ITEMS, std::memory_order_relaxed)) < itemCount) {
+                if (abort && abort->load(std::memory_order_relaxed)) break;
+                unsigned long count = (std::min)(BLOCK_ITEMS, itemCount - start);
+                randomx_init_dataset(target, source, start, count);
+                done.fetch_add(count, std::memory_order_relaxed);
+            }
+            finished.fetch_add(1, std::memory_order_release);
+        });
+    }
+
+    // Progress every 5 seconds; background builds only report with --debug
+    const bool report = !lowPriority || config.debugMode;
+    const auto begin = std::chrono::steady_clock::now();
+    auto lastReport = begin;
+    while (finished.load(std::memory_order_acquire) < numThreads) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        auto now = std::chrono::steady_clock::now();
+        if (!report || now - lastReport < std::chrono::seconds(5)) continue;
+        lastReport = now;
+        double elapsed = std::chrono::duration<double>(now - begin).count();
+        double items = static_cast<double>(done.load(std::memory_order_relaxed));
+        double rate = items / elapsed;
+        std::stringstream ss;
+        ss << std::fixed << std::setprecision(0) << "Dataset init: " << (items * 100.0 / itemCount) << "% | "
+           << std::setprecision(2) << (rate / 1e6) << "M items/s | ETA "
+           << std::setprecision(0) << (rate > 0 ? (itemCount - items) / rate : 0.0) << " s";
+        Utils::threadSafePrint(ss.str(), true);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    return !(abort && abort->load());
+}
+
+// The double buffer budget has to hold a second cache + dataset next to the active pair
+static uint64_t doubleBufferMiB() {
+    constexpr uint64_t CACHE_BYTES = 256ull << 20;  // RANDOMX_ARGON_MEMORY KiB
+    uint64_t bytes = static_cast<uint64_t>(randomx_dataset_item_count()) * RANDOMX_DATASET_ITEM_SIZE + CACHE_BYTES;
+    return (bytes + (1ull << 20) - 1) >> 20;
+}
+
+// Full mode needs the dataset and cache, a second cache while a dataset is
+// built in the background, and a scratchpad per mining thread
+static uint64_t fullModeMiB() {
+    return doubleBufferMiB() + 256 + 2ull * config.numThreads;
+}
+
+static bool selectLightMode() {
+    if (config.randomxMode == "light" || config.randomxMode == "full") {
+        return config.randomxMode == "light";
+    }
+    uint64_t availableMiB = Platform::getAvailableMemoryBytes() >> 20;
+    if (availableMiB >= fullModeMiB()) {
+        return false;
+    }
+    Utils::threadSafePrint("Available memory " + std::to_string(availableMiB) + " MiB is below the " +
+        std::to_string(fullModeMiB()) + " MiB full mode needs - using light mode", true);
+    return true;
+}
+
+// Dataset bytes on huge pages: all of it for hugetlb pages, else what THP backed
+static uint64_t datasetHugeBytes(randomx_dataset* ds) {
+    uint64_t bytes = static_cast<uint64_t>(randomx_dataset_item_count()) * RANDOMX_DATASET_ITEM_SIZE;
+    if (randomx_get_dataset_page_size(ds) > 0) return bytes;
+    return (std::min)(bytes, Platform::getTransparentHugePagesBytes(randomx_get_dataset_memory(ds), bytes));
+}
+
+// Page size the allocator actually got for a dataset (1 GiB falls back to 2 MiB, THP, then normal)
+static std::string datasetPageName(randomx_dataset* ds) {
+    size_t pageSize = randomx_get_dataset_page_size(ds);
+    if (pageSize >= (1ull << 30)) return "1 GiB pages";
+    if (pageSize > 0) return std::to_string(pageSize >> 20) + " MiB pages";
+    uint64_t thpBytes = datasetHugeBytes(ds);
+    if (thpBytes > 0) return "THP " + std::to_string(thpBytes >> 20) + " MiB";
+    return "normal pages";
+}
 
 bool RandomXManager::initializeCache(const std::string& seedHash) {
     std::lock_guard<std::mutex> lock(cacheMutex);
@@ -59,8 +252,8 @@ bool RandomXManager::initializeCache(const std::string& seedHash) {
         if (currentSeedHash == seedHash) {
             return true;
         }
-        randomx_release_cache(cache);
-        cache = nullptr;
+        // Same flags, new key: re-seed the allocation the VMs already point at
+        return seedCache(seedHash);
     }
 
     // Get base flags from RandomX
@@ -86,10 +279,19 @@ bool RandomXManager::initializeCache(const std::string& seedHash) {
         Utils::threadSafePrint("Large pages not available - using normal pages", true);
     }
     
-    useLightMode = false;
+    // 1 GiB pages only for the dataset; the 256 MB cache would waste most of one
+    if (Platform::has1GBPagesSupport()) {
+        flags |= RANDOMX_FLAG_1GB_PAGES;
+        Utils::threadSafePrint("1GB pages reserved - dataset will try them first", true);
+    }
+    
+    // Without a reserved pool the dataset can still get THP through madvise
+    if (Platform::hasTransparentHugePages()) {
+        flags |= RANDOMX_FLAG_THP;
+        Utils::threadSafePrint("Transparent huge pages available - dataset falls back to madvise", true);
+    }
     
     // Log what we're actually using
-    Utils::threadSafePrint("Mode: FULL (2GB dataset)", true);
     Utils::threadSafePrint("Cache flags: 0x" + Utils::formatHex(static_cast<uint64_t>(cacheAllocFlags), 8), true);
     Utils::threadSafePrint("VM/Dataset flags: 0x" + Utils::formatHex(static_cast<uint64_t>(flags), 8), true);
     
@@ -101,6 +303,8 @@ bool RandomXManager::initializeCache(const std::string& seedHash) {
         if (flags & RANDOMX_FLAG_HARD_AES) ss << "AES ";
         if (flags & RANDOMX_FLAG_FULL_MEM) ss << "FULL_MEM ";
         if (flags & RANDOMX_FLAG_LARGE_PAGES) ss << "LARGE_PAGES ";
+        if (flags & RANDOMX_FLAG_1GB_PAGES) ss << "1GB_PAGES ";
+        if (flags & RANDOMX_FLAG_THP) ss << "THP ";
         if (flags & RANDOMX_FLAG_SECURE) ss << "SECURE ";
         Utils::threadSafePrint(ss.str(), true);
     }
@@ -117,7 +321,11 @@ bool RandomXManager::initializeCache(const std::string& seedHash) {
             return false;
         }
     }
+    datasetAllocFlags = flags;
+    return seedCache(seedHash);
+}
 
+bool RandomXManager::seedCache(const std::string& seedHash) {
     std::vector<uint8_t> seedBytes = Utils::hexToBytes(seedHash);
     if (seedBytes.size() != 32) {
         Utils::threadSafePrint("ERROR: Invalid seed hash length: " + std::to_string(seedBytes.size()), true);
@@ -136,49 +344,34 @@ bool RandomXManager::createDataset() {
         return false;
     }
 
+    // A seed change rebuilds into the existing allocation: its pages are
+    // already faulted in and the parked VMs keep their dataset pointer
     if (dataset) {
-        randomx_release_dataset(dataset);
-        dataset = nullptr;
-    }
-
-    Utils::threadSafePrint("Allocating dataset with flags: 0x" + Utils::formatHex(static_cast<uint64_t>(flags), 8), true);
-    
-    dataset = randomx_alloc_dataset(static_cast<randomx_flags>(flags));
-    if (!dataset) {
-        Utils::threadSafePrint("Dataset allocation failed, trying FULL_MEM only", true);
-        flags = RANDOMX_FLAG_FULL_MEM;
-        dataset = randomx_alloc_dataset(RANDOMX_FLAG_FULL_MEM);
+        Utils::threadSafePrint("Reusing dataset memory (" + datasetPageName(dataset) + ")", true);
+    } else {
+        Utils::threadSafePrint("Allocating dataset with flags: 0x" + Utils::formatHex(static_cast<uint64_t>(flags), 8), true);
+        
+        dataset = allocDatasetOnNodes(flags, datasetHomeNodes());
         if (!dataset) {
-            Utils::threadSafePrint("Dataset allocation failed", true);
-            return false;
+            Utils::threadSafePrint("Dataset allocation failed, trying FULL_MEM only", true);
+            flags = RANDOMX_FLAG_FULL_MEM;
+            dataset = allocDatasetOnNodes(RANDOMX_FLAG_FULL_MEM, datasetHomeNodes());
+            if (!dataset) {
+                Utils::threadSafePrint("Dataset allocation failed", true);
+                return false;
+            }
         }
     }
 
     unsigned long itemCount = randomx_dataset_item_count();
     Utils::threadSafePrint("Initializing " + std::to_string(itemCount) + " dataset items...", true);
 
-    unsigned int numThreads = std::thread::hardware_concurrency();
-    if (numThreads == 0) numThreads = 1;
-    // Reserve one logical CPU for system responsiveness
-    if (numThreads > 1) numThreads = (std::max)(1u, numThreads - 1u);
-    Utils::threadSafePrint("Using " + std::to_string(numThreads) + " threads for dataset initialization (leaving 1 for system)", true);
+    unsigned int numThreads = datasetInitThreadCount();
+    Utils::threadSafePrint("Using " + std::to_string(numThreads) + " pinned threads for dataset initialization", true);
 
     auto start = std::chrono::high_resolution_clock::now();
 
-    std::vector<std::thread> threads;
-    unsigned long itemsPerThread = itemCount / numThreads;
-
-    for (unsigned int t = 0; t < numThreads; t++) {
-        unsigned long startIndex = t * itemsPerThread;
-        unsigned long count = (t == numThreads - 1) ? (itemCount - startIndex) : itemsPerThread;
-        threads.emplace_back([startIndex, count]() {
-            randomx_init_dataset(dataset, cache, startIndex, count);
-        });
-    }
-    
-    for (auto& thread : threads) {
-        thread.join();
-    }
+    initDatasetItems(dataset, cache, numThreads, nullptr, false, datasetHomeNodes());
     
     auto end = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
@@ -190,7 +383,7 @@ bool RandomXManager::createDataset() {
 }
 
 bool RandomXManager::initialize(const std::string& seedHash) {
-    std::lock_guard<std::mutex> lock(initMutex);
+    std::unique_lock<std::mutex> lock(initMutex);
     
     if (seedHash == currentSeedHash && cache != nullptr && initialized) {
         if (useLightMode || dataset != nullptr) {
@@ -198,6 +391,7 @@ bool RandomXManager::initialize(const std::string& seedHash) {
             return true;
         }
     }
+    stopSave();  // The dataset it reads is rebuilt or handed to the builder below
 
     Utils::threadSafePrint("=== INITIALIZING RANDOMX ===", true);
     Utils::threadSafePrint("Seed hash: " + seedHash, true);
@@ -208,40 +402,69 @@ bool RandomXManager::initialize(const std::string& seedHash) {
     }
     
     // Flags are already set in initializeCache with huge pages and JIT enabled if available
+    bool coldStart = !initialized;  // Not an in-place seed change
+    if (coldStart) {
+        lightModeSelected = selectLightMode();
+    }
+    useLightMode = lightModeSelected;
+    flags = datasetAllocFlags;
+    Utils::threadSafePrint(useLightMode ? "Mode: LIGHT (256MB cache)" : "Mode: FULL (2GB dataset)", true);
+    
+    if (config.numaReplicas && numaNodes.empty()) {
+        detectNumaNodes();
+    }
+    if (!numaNodes.empty()) {
+        // Dataset threads inherit this affinity, so the primary copy is
+        // first-touched on node 0; the other nodes get replicas below
+        Platform::pinCurrentThread(numaNodes[0].cpus);
+    }
     
+    bool hybridStart = false;
+    bool saveFile = false;
+    randomx_dataset* hybridDataset = nullptr;
     if (!useLightMode) {
-        std::string datasetFileName = "randomx_dataset_" + seedHash.substr(0, 16) + ".bin";
+        std::string datasetFileName = getDatasetPath(seedHash);
         bool loadedDataset = false;
         
-        if (std::filesystem::exists(datasetFileName)) {
-            size_t fileSize = std::filesystem::file_size(datasetFileName);
-            
-            unsigned long itemCount = randomx_dataset_item_count();
-            size_t expectedMinSize = static_cast<size_t>(itemCount) * RANDOMX_DATASET_ITEM_SIZE;
-            
-            if (fileSize >= expectedMinSize) {
-                Utils::threadSafePrint("Loading dataset from disk...", true);
-                if (loadDataset(datasetFileName)) {
-                    loadedDataset = true;
-                }
-            } else {
-                std::filesystem::remove(datasetFileName);
-            }
+        if (config.datasetFiles && !config.benchmark && std::filesystem::exists(datasetFileName)) {
+            Utils::threadSafePrint("Loading dataset from disk...", true);
+            loadedDataset = loadDataset(seedHash);
         }
 
-        if (!loadedDataset) {
+        if (!loadedDataset && coldStart && config.hybridStart && !config.benchmark) {
+            // Hash on light VMs right away; the dataset is built in the
+            // background and swapped in like a double-buffered one. Only on
+            // the first initialization: a mid-run seed change rebuilds in
+            // place while the threads are parked.
+            hybridStart = true;
+            hybridDataset = dataset;  // The background build fills it in
+            dataset = nullptr;
+        } else if (!loadedDataset) {
             Utils::threadSafePrint("=== CREATING 2GB RANDOMX DATASET ===", true);
             if (!createDataset()) {
                 useLightMode = true;
-                flags = cacheAllocFlags;
             } else {
-                saveDataset(datasetFileName);
+                saveFile = config.datasetFiles && !config.benchmark;
             }
         }
     }
+    if (useLightMode || hybridStart) {
+        useLightMode = true;
+        flags = cacheAllocFlags;
+    }
+    
+    if (!numaNodes.empty()) {
+        copyReplicas();
+        std::vector<unsigned int> allCpus;
+        for (const auto& node : numaNodes) {
+            allCpus.insert(allCpus.end(), node.cpus.begin(), node.cpus.end());
+        }
+        Platform::pinCurrentThread(allCpus);
+    }
 
     currentSeedHash = seedHash;
     initialized = true;
+    datasetGeneration.fetch_add(1, std::memory_order_acq_rel);
     
     // Print XMRig-style summary
     std::stringstream summary;
@@ -254,8 +477,12 @@ bool RandomXManager::initialize(const std::string& seedHash) {
     
     summary << totalSize << " MB (" << datasetSize << "+" << cacheSize << ")";
     
-    // Huge pages percentage
-    if (flags & RANDOMX_FLAG_LARGE_PAGES) {
+    // Huge pages percentage, with the page size the dataset really got
+    if (dataset) {
+        uint64_t datasetBytes = static_cast<uint64_t>(randomx_dataset_item_count()) * RANDOMX_DATASET_ITEM_SIZE;
+        summary << " huge pages " << (datasetHugeBytes(dataset) * 100 / datasetBytes) << "%";
+        summary << " (dataset: " << datasetPageName(dataset) << ")";
+    } else if (flags & RANDOMX_FLAG_LARGE_PAGES) {
         summary << " huge pages 100%";
     } else {
         summary << " huge pages 0%";
@@ -274,138 +501,94 @@ bool RandomXManager::initialize(const std::string& seedHash) {
     
     Utils::threadSafePrint(summary.str(), true);
     
-    if (config.debugMode) {
-        Utils::threadSafePrint("=== RANDOMX READY ===", true);
-        Utils::threadSafePrint("Flags: 0x" + Utils::formatHex(static_cast<uint64_t>(flags), 8), true);
+    if (config.datasetDoubleBufferMiB && !isDoubleBufferEnabled()) {
+        Utils::threadSafePrint("Dataset double buffer disabled: needs " + std::to_string(doubleBufferMiB()) +
+            " MiB in full mode", true);
     }
     
-    return true;
-}
-
-bool RandomXManager::createVM(int threadId) {
-    std::unique_lock<std::shared_mutex> lock(vmMutex);
-    
-    if (!initialized || !cache) {
-        Utils::threadSafePrint("Cannot create VM: RandomX not initialized", true);
-        return false;
-    }
-    
-    if (!useLightMode && !dataset) {
-        Utils::threadSafePrint("Cannot create VM: dataset required for full mode", true);
-        return false;
-    }
-
-    auto it = vms.find(threadId);
-    if (it != vms.end() && it->second != nullptr) {
-        return true;
-    }
-
-    // Only log in debug mode
     if (config.debugMode) {
-        Utils::threadSafePrint("Creating VM for thread " + std::to_string(threadId), true);
+        Utils::threadSafePrint("=== RANDOMX READY ===", true);
+        Utils::threadSafePrint("Flags: 0x" + Utils::formatHex(static_cast<uint64_t>(flags), 8), true);
     }
     
-    randomx_vm* vm = randomx_create_vm(
-        static_cast<randomx_flags>(flags), 
-        cache, 
-        useLightMode ? nullptr : dataset
-    );
-    
-    if (!vm) {
-        Utils::threadSafePrint("VM creation failed, trying fallback...", true);
-        int fallbackFlags = cacheAllocFlags & ~RANDOMX_FLAG_FULL_MEM;
-        vm = randomx_create_vm(static_cast<randomx_flags>(fallbackFlags), cache, nullptr);
-        if (!vm) {
-            Utils::threadSafePrint("VM creation failed completely", true);
-            return false;
-        }
+    // activateStandby() takes standbyMutex before initMutex, and so do these
+    lock.unlock();
+    if (saveFile) {
+        saveDataset(seedHash);
     }
-
-    vms[threadId] = vm;
-    if (config.debugMode) {
-        Utils::threadSafePrint("VM created successfully for thread " + std::to_string(threadId), true);
+    if (hybridStart) {
+        Utils::threadSafePrint("Hybrid start: hashing in light mode while the dataset is built", true);
+        if (hybridDataset) keepSpare(nullptr, hybridDataset);
+        startStandby(seedHash, false);  // Full speed: the light VMs are the slow part
     }
     return true;
 }
 
-bool RandomXManager::initializeVM(int threadId) {
-    if (!initialized) return false;
-    return createVM(threadId);
-}
-
-randomx_vm* RandomXManager::getVM(int threadId) {
-    std::shared_lock<std::shared_mutex> lock(vmMutex);
-    auto it = vms.find(threadId);
-    return (it != vms.end()) ? it->second : nullptr;
+std::string RandomXManager::getDatasetPath(const std::string& seedHash) {
+    return DatasetStore::pathFor(config.datasetDir, seedHash);
 }
 
-bool RandomXManager::loadDataset(const std::string& filename) {
-    unsigned long itemCount = randomx_dataset_item_count();
-    size_t actualDatasetSize = static_cast<size_t>(itemCount) * RANDOMX_DATASET_ITEM_SIZE;
-    
+bool RandomXManager::loadDataset(const std::string& seedHash) {
+    if (!cache) return false;
     if (!dataset) {
-        dataset = randomx_alloc_dataset(static_cast<randomx_flags>(flags));
+        dataset = allocDatasetOnNodes(flags, datasetHomeNodes());
         if (!dataset) return false;
     }
-
-    std::ifstream file(filename, std::ios::binary);
-    if (!file.is_open()) return false;
-
-    void* datasetMemory = randomx_get_dataset_memory(dataset);
-    if (!datasetMemory) { file.close(); return false; }
-
-    file.read(reinterpret_cast<char*>(datasetMemory), actualDatasetSize);
-    file.close();
-    return true;
+    return DatasetStore::load(getDatasetPath(seedHash), seedHash, cache, dataset, datasetInitThreadCount(), false);
 }
 
-bool RandomXManager::saveDataset(const std::string& filename) {
-    if (!dataset) return false;
-
-    unsigned long itemCount = randomx_dataset_item_count();
-    size_t actualDatasetSize = static_cast<size_t>(itemCount) * RANDOMX_DATASET_ITEM_SIZE;
-
-    std::ofstream file(filename, std::ios::binary);
-    if (!file.is_open()) return false;
-
-    void* datasetMemory = randomx_get_dataset_memory(dataset);
-    if (!datasetMemory) { file.close(); return false; }
-
-    file.write(reinterpret_cast<const char*>(datasetMemory), actualDatasetSize);
-    file.close();
-    return true;
-}
+bool RandomXManager::saveDataset(const std::string& seedHash) {
+    std::string nextSeedHash;
+    {
+        std::lock_guard<std::mutex> lock(standbyMutex);
+        nextSeedHash = standbySeedHash;
+    }
+    DatasetStore::prune(config.datasetDir, {seedHash, nextSeedHash});
 
-void RandomXManager::cleanupVM(int threadId) {
-    std::unique_lock<std::shared_mutex> lock(vmMutex);
-    auto it = vms.find(threadId);
-    if (it != vms.end() && it->second) {
-        randomx_destroy_vm(it->second);
-        vms.erase(it);
+    // Writing 2 GiB takes seconds, so it runs beside the mining threads at low
+    // priority instead of holding up initialize() and the network thread
+    std::lock_guard<std::mutex> lock(initMutex);
+    if (seedHash != currentSeedHash || useLightMode || !dataset) {
+        return false;
     }
+    stopSave();
+    std::lock_guard<std::mutex> saveLock(saveMutex);
+    saveThread = std::thread([seedHash, source = dataset]() {
+        Platform::lowerCurrentThreadPriority();
+        DatasetStore::save(getDatasetPath(seedHash), seedHash, source, datasetInitThreadCount(), true, &saveAbort);
+    });
+    return true;
 }
 
-void RandomXManager::destroyVM(randomx_vm* vm) {
-    if (!vm) return;
-    std::unique_lock<std::shared_mutex> lock(vmMutex);
-    for (auto it = vms.begin(); it != vms.end(); ++it) {
-        if (it->second == vm) {
-            randomx_destroy_vm(vm);
-            vms.erase(it);
-            break;
-        }
+void RandomXManager::stopSave() {
+    std::unique_lock<std::mutex> lock(saveMutex);
+    if (!saveThread.joinable()) {
+        return;
     }
+    std::thread writer = std::move(saveThread);
+    saveAbort.store(true);
+    lock.unlock();
+    writer.join();
+    lock.lock();
+    saveAbort.store(false);
 }
 
 void RandomXManager::cleanup() {
-    std::lock_guard<std::mutex> lock(initMutex);
+    stopSave();
+    stopStandby();
+    releaseRetired();
     {
-        std::unique_lock<std::shared_mutex> vmLock(vmMutex);
-        for (auto& [threadId, vm] : vms) {
-            if (vm) randomx_destroy_vm(vm);
-        }
-        vms.clear();
+        std::lock_guard<std::mutex> standbyLock(standbyMutex);
+        if (spareCache) { randomx_release_cache(spareCache); spareCache = nullptr; }
+        if (spareDataset) { randomx_release_dataset(spareDataset); spareDataset = nullptr; }
+    }
+    std::lock_guard<std::mutex> lock(initMutex);
+    replicasCurrent.store(false);
+    for (randomx_dataset*& replica : replicas) {
+        if (replica) { randomx_release_dataset(replica); replica = nullptr; }
     }
+    replicas.clear();
+    numaNodes.clear();
     if (cache) { randomx_release_cache(cache); cache = nullptr; }
     if (dataset) { randomx_release_dataset(dataset); dataset = nullptr; }
     initialized = false;
@@ -413,24 +596,28 @@ void RandomXManager::cleanup() {
 }
 
 bool RandomXManager::setTargetAndDifficulty(const std::string& targetHex) {
-    if (targetHex.length() != 8) {
+    if (targetHex.length() != 8 && targetHex.length() != 16) {
         return false;
     }
     
     try {
         std::lock_guard<std::mutex> lock(targetMutex);
         
-        // Parse 4-byte compact target
+        // Parse 4-byte compact or 8-byte (difficulty above 2^32) target
         std::vector<uint8_t> targetBytes = Utils::hexToBytes(targetHex);
-        uint32_t compactTarget = 0;
-        for (size_t i = 0; i < 4; i++) {
-            compactTarget |= static_cast<uint32_t>(targetBytes[i]) << (i * 8);
+        if (targetBytes.size() != targetHex.length() / 2) {
+            return false;
+        }
+        uint64_t targetValue = 0;
+        for (size_t i = 0; i < targetBytes.size(); i++) {
+            targetValue |= static_cast<uint64_t>(targetBytes[i]) << (i * 8);
         }
         
-        if (compactTarget == 0) compactTarget = 1;
+        if (targetValue == 0) targetValue = 1;
         
         // Calculate difficulty
-        currentDifficulty = static_cast<double>(0xFFFFFFFFULL) / static_cast<double>(compactTarget);
+        uint64_t targetMax = targetBytes.size() == 4 ? 0xFFFFFFFFULL : 0xFFFFFFFFFFFFFFFFULL;
+        currentDifficulty = static_cast<double>(targetMax) / static_cast<double>(targetValue);
         
         // Calculate 256-bit target
         uint64_t diff64 = static_cast<uint64_t>(currentDifficulty);
@@ -442,7 +629,7 @@ bool RandomXManager::setTargetAndDifficulty(const std::string& targetHex) {
         
         if (config.debugMode) {
             std::stringstream ss;
-            ss << "[TARGET] 0x" << std::hex << compactTarget 
+            ss << "[TARGET] 0x" << std::hex << targetValue 
                << " -> Diff:" << std::dec << diff64
                << " -> Target[0]=0x" << std::hex << std::setw(16) << std::setfill('0') 
                << expandedTarget.data[0];
@@ -530,73 +717,327 @@ randomx_flags RandomXManager::getVMFlags() {
     return static_cast<randomx_flags>(flags);
 }
 
+RandomXManager::VMBinding RandomXManager::getVMBinding(size_t numaNode) {
+    std::lock_guard<std::mutex> lock(initMutex);
+    VMBinding binding;
+    binding.cache = cache;
+    binding.dataset = getDatasetForNode(numaNode);
+    binding.flags = static_cast<randomx_flags>(flags);
+    binding.generation = datasetGeneration.load(std::memory_order_acquire);
+    return binding;
+}
+
 void RandomXManager::handleSeedHashChange(const std::string& newSeedHash) {
     std::lock_guard<std::mutex> lock(seedHashMutex);
+    // A standby for the current seed is the full dataset of a hybrid start
+    if (activateStandby(newSeedHash)) {
+        return;
+    }
     if (newSeedHash != currentSeedHash) {
-        {
-            std::unique_lock<std::shared_mutex> vmLock(vmMutex);
-            for (auto& [threadId, vm] : vms) {
-                if (vm) randomx_destroy_vm(vm);
+        stopStandby();  // Not ready, so superseded (e.g. a hybrid build for the old seed)
+        initialize(newSeedHash);
+    }
+}
+
+bool RandomXManager::isDoubleBufferEnabled() {
+    return !useLightMode && config.datasetDoubleBufferMiB >= doubleBufferMiB();
+}
+
+void RandomXManager::prepareSeed(const std::string& seedHash) {
+    if (seedHash.empty() || seedHash == currentSeedHash) {
+        return;
+    }
+    startStandby(seedHash, true);
+}
+
+void RandomXManager::startStandby(const std::string& seedHash, bool lowPriority) {
+    std::unique_lock<std::mutex> lock(standbyMutex);
+    if (seedHash == standbySeedHash) {
+        return;
+    }
+
+    // A newer seed supersedes whatever the builder was doing. The builder
+    // takes standbyMutex to publish its result, so join without holding it
+    if (standbyThread.joinable()) {
+        std::thread previous = std::move(standbyThread);
+        standbyAbort.store(true);
+        lock.unlock();
+        previous.join();
+        lock.lock();
+        standbyAbort.store(false);
+    }
+    // A superseded pair becomes the new builder's memory
+    if (standbyCache) {
+        if (spareCache) randomx_release_cache(spareCache);
+        spareCache = standbyCache;
+        standbyCache = nullptr;
+    }
+    if (standbyDataset) {
+        if (spareDataset) randomx_release_dataset(spareDataset);
+        spareDataset = standbyDataset;
+        standbyDataset = nullptr;
+    }
+
+    standbySeedHash = seedHash;
+    standbyBuilding.store(true);
+    standbyThread = std::thread(buildStandby, seedHash, currentSeedHash, lowPriority);
+    Utils::threadSafePrint("Building dataset for seed " + seedHash.substr(0, 16) + "... in the background", true);
+}
+
+bool RandomXManager::isStandbyPending(const std::string& seedHash) {
+    std::lock_guard<std::mutex> lock(standbyMutex);
+    return seedHash == standbySeedHash && standbyBuilding.load();
+}
+
+bool RandomXManager::isStandbyReady(const std::string& seedHash) {
+    std::lock_guard<std::mutex> lock(standbyMutex);
+    return seedHash == standbySeedHash && !standbyBuilding.load() && standbyCache && standbyDataset;
+}
+
+void RandomXManager::buildStandby(const std::string& seedHash, const std::string& activeSeedHash, bool lowPriority) {
+    if (lowPriority) Platform::lowerCurrentThreadPriority();
+    if (!numaNodes.empty()) {
+        Platform::pinCurrentThread(numaNodes[0].cpus);  // Becomes node 0's dataset
+    }
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<uint8_t> seedBytes = Utils::hexToBytes(seedHash);
+    randomx_cache* nextCache = nullptr;
+    randomx_dataset* nextDataset = nullptr;
+    {
+        // Memory of a retired or superseded pair, if any, is already faulted in
+        std::lock_guard<std::mutex> lock(standbyMutex);
+        std::swap(nextCache, spareCache);
+        std::swap(nextDataset, spareDataset);
+    }
+    if (seedBytes.size() == 32) {
+        if (!nextCache) nextCache = randomx_alloc_cache(static_cast<randomx_flags>(cacheAllocFlags));
+        if (!nextCache) nextCache = randomx_alloc_cache(static_cast<randomx_flags>(cacheAllocFlags & ~RANDOMX_FLAG_LARGE_PAGES));
+        if (!nextDataset) nextDataset = allocDatasetOnNodes(datasetAllocFlags, datasetHomeNodes());
+        if (!nextDataset) nextDataset = allocDatasetOnNodes(RANDOMX_FLAG_FULL_MEM, datasetHomeNodes());
+    }
+
+    bool built = nextCache && nextDataset;
+    if (built) {
+        randomx_init_cache(nextCache, seedBytes.data(), seedBytes.size());
+        std::string datasetFileName = getDatasetPath(seedHash);
+        if (!config.datasetFiles || !std::filesystem::exists(datasetFileName) ||
+            !DatasetStore::load(datasetFileName, seedHash, nextCache, nextDataset, datasetInitThreadCount(), lowPriority)) {
+            built = initDatasetItems(nextDataset, nextCache, datasetInitThreadCount(), &standbyAbort, lowPriority,
+                                     datasetHomeNodes());
+            if (built && config.datasetFiles) {
+                DatasetStore::prune(config.datasetDir, {activeSeedHash, seedHash});
+                DatasetStore::save(datasetFileName, seedHash, nextDataset, datasetInitThreadCount(), lowPriority,
+                                   &standbyAbort);
             }
-            vms.clear();
         }
-        initialize(newSeedHash);
     }
+
+    std::lock_guard<std::mutex> lock(standbyMutex);
+    if (built) {
+        standbyCache = nextCache;
+        standbyDataset = nextDataset;
+        standbyReadyAt = std::chrono::steady_clock::now();
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+        Utils::threadSafePrint("Background dataset for seed " + seedHash.substr(0, 16) + "... ready in " +
+            std::to_string(ms / 1000.0) + " seconds", true);
+    } else {
+        // Superseded or failed: the memory is kept for the next build
+        if (nextCache && !spareCache) std::swap(nextCache, spareCache);
+        if (nextDataset && !spareDataset) std::swap(nextDataset, spareDataset);
+        if (nextCache) randomx_release_cache(nextCache);
+        if (nextDataset) randomx_release_dataset(nextDataset);
+        if (!standbyAbort.load()) {
+            Utils::threadSafePrint("Background dataset build failed - seed change will rebuild in place", true);
+        }
+    }
+    standbyBuilding.store(false);
 }
 
-bool RandomXManager::calculateHashForThread(int threadId, const std::vector<uint8_t>& input, uint64_t nonce) {
-    // Note: nonce parameter kept for API compatibility but not used
-    // The nonce is already embedded in the input blob by the calling code
-    (void)nonce; // Suppress unused parameter warning
-    
-    randomx_vm* vm = nullptr;
+bool RandomXManager::activateStandby(const std::string& seedHash) {
+    std::lock_guard<std::mutex> standbyLock(standbyMutex);
+    if (seedHash != standbySeedHash || standbyBuilding.load() || !standbyCache || !standbyDataset) {
+        return false;
+    }
+    if (standbyThread.joinable()) standbyThread.join();  // Already past its last lock
+
+    std::lock_guard<std::mutex> lock(initMutex);
+
+    // Mining threads still point at the old pair until they rebind, so it is
+    // only parked here; the caller frees it once they all moved on
+    if (retiredCache) randomx_release_cache(retiredCache);
+    if (retiredDataset) randomx_release_dataset(retiredDataset);
+    retiredCache = cache;
+    retiredDataset = dataset;
+    cache = standbyCache;
+    dataset = standbyDataset;
+    standbyCache = nullptr;
+    standbyDataset = nullptr;
+    standbySeedHash.clear();
+    bool fromLightMode = useLightMode;
+    useLightMode = false;
+    flags = datasetAllocFlags;  // VMs rebinding to the new pair are full-mode ones
+    currentSeedHash = seedHash;
+    replicasCurrent.store(false, std::memory_order_release);  // Until refreshReplicas()
+    datasetGeneration.fetch_add(1, std::memory_order_acq_rel);
+
+    if (fromLightMode) {
+        Utils::threadSafePrint("Dataset ready - switching mining threads from light to full mode", true);
+        return true;
+    }
+
+    // Lead time of the precomputation: how long the standby waited for the flip
+    auto leadMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - standbyReadyAt).count();
+    Utils::threadSafePrint("Switched to dataset for seed " + seedHash.substr(0, 16) + "... (ready " +
+        std::to_string(leadMs / 1000.0) + " seconds before the switch)", true);
+    return true;
+}
+
+void RandomXManager::releaseRetired() {
+    stopSave();  // Still writing the retired dataset's file after a quick swap
+    randomx_cache* oldCache = nullptr;
+    randomx_dataset* oldDataset = nullptr;
     {
-        std::shared_lock<std::shared_mutex> vmLock(vmMutex);
-        auto it = vms.find(threadId);
-        if (it == vms.end() || !it->second) return false;
-        vm = it->second;
+        std::lock_guard<std::mutex> lock(standbyMutex);
+        std::swap(oldCache, retiredCache);
+        std::swap(oldDataset, retiredDataset);
     }
-    
-    if (!initialized || input.empty() || input.size() > MAX_BLOB_SIZE) return false;
-    
-    alignas(64) uint8_t blob[MAX_BLOB_SIZE];
-    alignas(64) uint8_t hash[RANDOMX_HASH_SIZE];
-    
-    // CRITICAL FIX: DON'T insert nonce - it's already in the input blob!
-    // The calling code (MoneroMiner.cpp) already wrote the nonce to the blob
-    memcpy(blob, input.data(), input.size());
-    
-    // Calculate hash directly
-    randomx_calculate_hash(vm, blob, input.size(), hash);
-    
-    // Debug logging (only every 10000th hash)
-    static std::atomic<uint64_t> hashCounter{0};
-    uint64_t count = hashCounter.fetch_add(1);
-    
-    if (config.debugMode && (count % 10000 == 0)) {
-        std::stringstream ss;
-        ss << "\n[RandomX] Hash #" << count;
-        ss << "\n  Input blob (first 50 bytes): ";
-        for (size_t i = 0; i < 50 && i < input.size(); i++) {
-            ss << std::hex << std::setw(2) << std::setfill('0') << static_cast<int>(input[i]) << " ";
+    // With double buffering the next seed's build needs a pair again soon
+    if (isDoubleBufferEnabled()) {
+        keepSpare(oldCache, oldDataset);
+        return;
+    }
+    if (oldCache) randomx_release_cache(oldCache);
+    if (oldDataset) randomx_release_dataset(oldDataset);
+}
+
+void RandomXManager::keepSpare(randomx_cache* spareCachePtr, randomx_dataset* spareDatasetPtr) {
+    std::lock_guard<std::mutex> lock(standbyMutex);
+    if (spareCachePtr) {
+        if (spareCache) randomx_release_cache(spareCache);
+        spareCache = spareCachePtr;
+    }
+    if (spareDatasetPtr) {
+        if (spareDataset) randomx_release_dataset(spareDataset);
+        spareDataset = spareDatasetPtr;
+    }
+}
+
+void RandomXManager::stopStandby() {
+    std::unique_lock<std::mutex> lock(standbyMutex);
+    if (standbyThread.joinable()) {
+        std::thread builder = std::move(standbyThread);
+        standbyAbort.store(true);
+        lock.unlock();
+        builder.join();
+        lock.lock();
+        standbyAbort.store(false);
+    }
+    if (standbyCache) { randomx_release_cache(standbyCache); standbyCache = nullptr; }
+    if (standbyDataset) { randomx_release_dataset(standbyDataset); standbyDataset = nullptr; }
+    if (!isDoubleBufferEnabled()) {
+        // Nothing will build in the background again
+        if (spareCache) { randomx_release_cache(spareCache); spareCache = nullptr; }
+        if (spareDataset) { randomx_release_dataset(spareDataset); spareDataset = nullptr; }
+    }
+    standbySeedHash.clear();
+}
+
+void RandomXManager::detectNumaNodes() {
+    std::vector<Platform::NumaNode> nodes = Platform::getNumaNodes();
+    if (nodes.size() < 2) {
+        return;
+    }
+    numaNodes = nodes;
+    replicas.assign(nodes.size(), nullptr);
+    Utils::threadSafePrint("NUMA: " + std::to_string(nodes.size()) + " nodes - one dataset replica per node", true);
+}
+
+// Nodes that first-touch a new primary dataset: node 0 alone when replicating
+// (the others get copies), otherwise every node for its share
+std::vector<Platform::NumaNode> RandomXManager::datasetHomeNodes() {
+    if (!numaNodes.empty()) return { numaNodes[0] };
+    return Platform::getNumaNodes();
+}
+
+const Platform::NumaNode* RandomXManager::getNumaNode(size_t index) {
+    return index < numaNodes.size() ? &numaNodes[index] : nullptr;
+}
+
+randomx_dataset* RandomXManager::getDatasetForNode(size_t index) {
+    if (index > 0 && index < replicas.size() && replicas[index] &&
+        replicasCurrent.load(std::memory_order_acquire)) {
+        return replicas[index];
+    }
+    return dataset;
+}
+
+// Copies the primary dataset into every other node's replica. A replica is
+// allocated under its node's memory policy and copied by threads pinned to
+// the node, so its pages land there whatever their size.
+// No VM may be bound to a replica while this runs.
+bool RandomXManager::copyReplicas() {
+    replicasCurrent.store(false, std::memory_order_release);
+    if (numaNodes.size() < 2 || useLightMode || !dataset) {
+        return false;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    const uint8_t* source = static_cast<const uint8_t*>(randomx_get_dataset_memory(dataset));
+    size_t datasetSize = static_cast<size_t>(randomx_dataset_item_count()) * RANDOMX_DATASET_ITEM_SIZE;
+    size_t copied = 0;
+    std::string placement;
+
+    for (size_t node = 1; node < numaNodes.size(); node++) {
+        if (!replicas[node]) {
+            replicas[node] = allocDatasetOnNodes(flags, {numaNodes[node]});
+            if (!replicas[node]) replicas[node] = allocDatasetOnNodes(RANDOMX_FLAG_FULL_MEM, {numaNodes[node]});
+            if (!replicas[node]) {
+                Utils::threadSafePrint("NUMA: no memory for a replica on node " + std::to_string(numaNodes[node].id) +
+                    " - its threads read node " + std::to_string(numaNodes[0].id) + "'s dataset", true);
+                continue;
+            }
         }
-        ss << "\n  Hash LSW: 0x" << std::hex << std::setw(16) << std::setfill('0');
-        uint64_t hashLSW = 0;
-        for (int i = 0; i < 8; i++) {
-            hashLSW |= static_cast<uint64_t>(hash[i]) << (i * 8);
+
+        uint8_t* target = static_cast<uint8_t*>(randomx_get_dataset_memory(replicas[node]));
+        const std::vector<unsigned int>& cpus = numaNodes[node].cpus;
+        size_t numThreads = cpus.size();
+        size_t slice = (datasetSize / numThreads) & ~static_cast<size_t>(RANDOMX_DATASET_ITEM_SIZE - 1);
+
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < numThreads; t++) {
+            size_t offset = t * slice;
+            size_t size = (t == numThreads - 1) ? datasetSize - offset : slice;
+            threads.emplace_back([&cpus, target, source, offset, size]() {
+                Platform::pinCurrentThread(cpus);
+                std::memcpy(target + offset, source + offset, size);
+            });
         }
-        ss << hashLSW;
-        ss << " | Target LSW: 0x" << std::hex << std::setw(16) << std::setfill('0') << expandedTarget.data[0];
-        Utils::threadSafePrint(ss.str(), true);
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        copied++;
+        uint64_t localBytes = Platform::getNumaNodeBytes(target, datasetSize, numaNodes[node].id);
+        placement += (placement.empty() ? " (" : ", ") + std::string("node ") + std::to_string(numaNodes[node].id) +
+                     ": " + std::to_string(localBytes * 100 / datasetSize) + "% local";
     }
-    
-    bool wouldBeValid = checkTarget(hash);
-    
-    if (wouldBeValid) {
-        Utils::threadSafePrint("\n!!! VALID SHARE DETECTED !!!", true);
+    if (!placement.empty()) placement += ")";
+
+    replicasCurrent.store(true, std::memory_order_release);
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    Utils::threadSafePrint("NUMA: dataset replicated to " + std::to_string(copied) + " node(s) in " +
+        std::to_string(ms / 1000.0) + " seconds" + placement, true);
+    return copied > 0;
+}
+
+void RandomXManager::refreshReplicas() {
+    std::lock_guard<std::mutex> lock(initMutex);
+    if (numaNodes.empty()) {
+        return;
     }
-    
-    return wouldBeValid;
+    copyReplicas();
+    datasetGeneration.fetch_add(1, std::memory_order_acq_rel);
 }
 
 double RandomXManager::getDifficulty() {
@@ -3,11 +3,13 @@
 #include <vector>
 #include <string>
 #include <mutex>
-#include <shared_mutex>
-#include <unordered_map>
+#include <atomic>
+#include <chrono>
+#include <thread>
 #include "randomx.h"
 #include "Types.h"  // FIX: Ensure Types.h is included
 #include "Difficulty.h"
+#include "Platform.h"
 #include <filesystem>
 
 class MiningThreadData;
@@ -16,18 +18,9 @@ class RandomXManager {
 public:
     // Initialization
     static bool initialize(const std::string& seedHash);
-    static bool initializeVM(int threadId);
     static bool initializeCache(const std::string& seedHash);
     
-    // VM management
-    static bool createVM(int threadId);
-    static randomx_vm* getVM(int threadId);
-    static void cleanupVM(int threadId);
     static void cleanup();
-    static void destroyVM(randomx_vm* vm);
-    
-    // Hash calculation - PRIMARY METHOD for mining threads
-    static bool calculateHashForThread(int threadId, const std::vector<uint8_t>& input, uint64_t nonce);
     
     // Target/difficulty
     static bool setTargetAndDifficulty(const std::string& targetHex);
@@ -39,13 +32,49 @@ public:
     
     // Dataset management
     static bool createDataset();
-    static bool loadDataset(const std::string& filename);
-    static bool saveDataset(const std::string& filename);
+    static bool loadDataset(const std::string& seedHash);  // Seed-keyed file, see DatasetStore
+    static bool saveDataset(const std::string& seedHash);  // In the background; not under initMutex
     static std::string getDatasetPath(const std::string& seedHash);
     
     // Utility
     static void handleSeedHashChange(const std::string& newSeedHash);
     
+    // Double buffering (--dataset-double-buffer): the next seed's cache and
+    // dataset are built by a low-priority background thread while mining
+    // continues, and handleSeedHashChange swaps them in. The replaced pair is
+    // kept until releaseRetired(), once no VM points at it any more.
+    // A hybrid start builds the current seed's dataset the same way while
+    // light VMs hash; its swap is what moves the threads to full mode.
+    static bool isDoubleBufferEnabled();
+    static void prepareSeed(const std::string& seedHash);
+    static bool isStandbyPending(const std::string& seedHash);  // Still building
+    static bool isStandbyReady(const std::string& seedHash);    // Built, not yet swapped in
+    static bool isStandbyBuilding() { return standbyBuilding.load(); }
+    static void releaseRetired();
+    
+    // Bumped whenever the active cache/dataset pair changes
+    static uint64_t getDatasetGeneration() { return datasetGeneration.load(std::memory_order_acquire); }
+    
+    // NUMA replication: on multi-node machines every node gets its own copy
+    // of the dataset, first touched by threads pinned to that node. Mining
+    // threads bind to their node's replica and are pinned to its CPUs.
+    static size_t getNumaNodeCount() { return numaNodes.empty() ? 1 : numaNodes.size(); }
+    static const Platform::NumaNode* getNumaNode(size_t index);
+    static randomx_dataset* getDatasetForNode(size_t index);
+    static void refreshReplicas();  // After a double-buffered swap
+    
+    // What a mining thread's own VM binds to: the cache, its node's dataset
+    // (null in light mode), the VM flags and the generation they belong to.
+    // Read together under initMutex, which every writer of the pair holds, so
+    // a swap on the network thread is never seen half done.
+    struct VMBinding {
+        randomx_cache* cache = nullptr;
+        randomx_dataset* dataset = nullptr;
+        randomx_flags flags = RANDOMX_FLAG_DEFAULT;
+        uint64_t generation = 0;
+    };
+    static VMBinding getVMBinding(size_t numaNode);
+    
     // Getters
     static bool isInitialized() { return initialized; }
     static const std::string& getCurrentSeedHash() { return currentSeedHash; }
@@ -54,19 +83,52 @@ public:
     static randomx_flags getVMFlags();
 
 private:
-    static std::shared_mutex vmMutex;
+    static bool activateStandby(const std::string& seedHash);
+    static void startStandby(const std::string& seedHash, bool lowPriority);
+    static void buildStandby(const std::string& seedHash, const std::string& activeSeedHash, bool lowPriority);
+    static void stopStandby();
+    static void stopSave();  // Cancels and joins the background dataset write
+    static void detectNumaNodes();
+    static std::vector<Platform::NumaNode> datasetHomeNodes();
+    static bool copyReplicas();
+    static bool seedCache(const std::string& seedHash);
+    static void keepSpare(randomx_cache* spareCachePtr, randomx_dataset* spareDatasetPtr);
+
     static std::mutex initMutex;
     static std::mutex hashMutex;
     static std::mutex cacheMutex;
     static std::mutex seedHashMutex;
     static std::mutex targetMutex;
     
-    static std::unordered_map<int, randomx_vm*> vms;
     static randomx_cache* cache;
     static randomx_dataset* dataset;
     static std::string currentSeedHash;
     static bool initialized;
     static bool useLightMode;
+    static std::atomic<uint64_t> datasetGeneration;
+    
+    static std::vector<Platform::NumaNode> numaNodes;  // Empty unless replicating
+    static std::vector<randomx_dataset*> replicas;     // Per node; node 0 uses the primary dataset
+    static std::atomic<bool> replicasCurrent;          // Replicas hold the active seed
+    
+    static std::mutex standbyMutex;  // Guards the standby/retired pairs below
+    static std::thread standbyThread;
+    static std::string standbySeedHash;
+    static std::atomic<bool> standbyBuilding;
+    static std::atomic<bool> standbyAbort;
+    static std::chrono::steady_clock::time_point standbyReadyAt;
+    static randomx_cache* standbyCache;
+    static randomx_dataset* standbyDataset;
+    static randomx_cache* retiredCache;
+    static randomx_dataset* retiredDataset;
+    static randomx_cache* spareCache;      // Freed pair kept as the next build's memory
+    static randomx_dataset* spareDataset;
+    
+    // The background dataset write only reads the active dataset; anything
+    // that rewrites or frees it calls stopSave() first
+    static std::mutex saveMutex;  // Guards saveThread
+    static std::thread saveThread;
+    static std::atomic<bool> saveAbort;
     
     static std::vector<uint8_t> lastHash;
     static uint256_t expandedTarget;  // FIX: Ensure uint256_t is defined before use
@@ -0,0 +1,44 @@
+#include "ShareQueue.h"
+
+static_assert((ShareQueue::CAPACITY & (ShareQueue::CAPACITY - 1)) == 0, "CAPACITY must be a power of two");
+
+ShareQueue::ShareQueue() {
+    for (size_t i = 0; i < CAPACITY; i++) {
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+bool ShareQueue::push(const ShareSubmission& share) {
+    size_t pos = enqueuePos.load(std::memory_order_relaxed);
+    for (;;) {
+        Slot& slot = slots[pos & (CAPACITY - 1)];
+        size_t sequence = slot.sequence.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+
+        if (diff == 0) {
+            // Slot is free for this position - claim it
+            if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                slot.share = share;
+                slot.sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false;  // Consumer has not freed this slot yet - queue full
+        } else {
+            pos = enqueuePos.load(std::memory_order_relaxed);  // Another producer won
+        }
+    }
+}
+
+bool ShareQueue::pop(ShareSubmission& share) {
+    Slot& slot = slots[dequeuePos & (CAPACITY - 1)];
+    size_t sequence = slot.sequence.load(std::memory_order_acquire);
+    if (static_cast<intptr_t>(sequence) - static_cast<intptr_t>(dequeuePos + 1) < 0) {
+        return false;  // Empty (or the producer is still copying)
+    }
+
+    share = slot.share;
+    slot.sequence.store(dequeuePos + CAPACITY, std::memory_order_release);
+    dequeuePos++;
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+// Everything a mining thread hands over for a found share - plain data,
+// copied into the queue without touching the heap
+struct ShareSubmission {
+    uint64_t generation;  // Job snapshot the nonce was hashed against
+    uint32_t nonce;
+    uint8_t hash[32];
+    std::chrono::steady_clock::time_point foundAt;
+};
+
+// Bounded lock-free multi-producer/single-consumer queue (sequence-numbered
+// ring). Mining threads push; only the pool network thread pops.
+class ShareQueue {
+public:
+    static constexpr size_t CAPACITY = 256;  // Power of two
+
+    ShareQueue();
+
+    bool push(const ShareSubmission& share);  // Any thread; false when full
+    bool pop(ShareSubmission& share);         // Consumer thread only
+
+private:
+    struct Slot {
+        std::atomic<size_t> sequence;
+        ShareSubmission share;
+    };
+
+    Slot slots[CAPACITY];
+    alignas(64) std::atomic<size_t> enqueuePos{0};
+    alignas(64) size_t dequeuePos = 0;
+};
\ No newline at end of file
@@ -0,0 +1,167 @@
+#include "Stratum.h"
+#include <cstring>
+
+namespace Stratum {
+
+namespace {
+
+struct Cursor {
+    const char* pos;
+    const char* end;
+
+    void skipSpace() {
+        while (pos < end && (*pos == ' ' || *pos == '\t' || *pos == '\r' || *pos == '\n')) pos++;
+    }
+    bool consume(char c) {
+        skipSpace();
+        if (pos < end && *pos == c) {
+            pos++;
+            return true;
+        }
+        return false;
+    }
+    bool peek(char c) {
+        skipSpace();
+        return pos < end && *pos == c;
+    }
+};
+
+// A string value without its quotes. Escaped strings are reported so the
+// caller can fall back: none of the job fields ever needs escaping.
+bool readString(Cursor& c, std::string_view& out, bool& escaped) {
+    if (!c.consume('"')) return false;
+    const char* start = c.pos;
+    for (;;) {
+        const char* quote = static_cast<const char*>(std::memchr(c.pos, '"', c.end - c.pos));
+        if (quote == nullptr) return false;
+        // An odd run of backslashes before the quote escapes it
+        const char* backslash = quote;
+        while (backslash > start && backslash[-1] == '\\') backslash--;
+        c.pos = quote + 1;
+        if ((quote - backslash) % 2 == 0) {
+            out = std::string_view(start, static_cast<size_t>(quote - start));
+            escaped = std::memchr(start, '\\', out.size()) != nullptr;
+            return true;
+        }
+    }
+}
+
+bool readPlainString(Cursor& c, std::string_view& out) {
+    bool escaped;
+    return readString(c, out, escaped) && !escaped;
+}
+
+// Unsigned decimal integer; fractions, exponents and signs go to picojson
+bool readUnsigned(Cursor& c, uint64_t& out) {
+    c.skipSpace();
+    const char* start = c.pos;
+    uint64_t value = 0;
+    while (c.pos < c.end && *c.pos >= '0' && *c.pos <= '9') {
+        uint64_t digit = static_cast<uint64_t>(*c.pos - '0');
+        if (value > (UINT64_MAX - digit) / 10) return false;
+        value = value * 10 + digit;
+        c.pos++;
+    }
+    if (c.pos == start || (c.pos < c.end && (*c.pos == '.' || *c.pos == 'e' || *c.pos == 'E'))) return false;
+    out = value;
+    return true;
+}
+
+// Steps over any value, nested or not, without looking at it
+bool skipValue(Cursor& c) {
+    c.skipSpace();
+    if (c.pos >= c.end) return false;
+    if (*c.pos == '"') {
+        std::string_view ignored;
+        bool escaped;
+        return readString(c, ignored, escaped);
+    }
+    if (*c.pos == '{' || *c.pos == '[') {
+        int depth = 0;
+        while (c.pos < c.end) {
+            char ch = *c.pos;
+            if (ch == '"') {
+                std::string_view ignored;
+                bool escaped;
+                if (!readString(c, ignored, escaped)) return false;
+                continue;
+            }
+            c.pos++;
+            if (ch == '{' || ch == '[') depth++;
+            else if ((ch == '}' || ch == ']') && --depth == 0) return true;
+        }
+        return false;
+    }
+    // Number, true, false or null
+    const char* start = c.pos;
+    while (c.pos < c.end && *c.pos != ',' && *c.pos != '}' && *c.pos != ']' &&
+           *c.pos != ' ' && *c.pos != '\t' && *c.pos != '\r' && *c.pos != '\n') {
+        c.pos++;
+    }
+    return c.pos != start;
+}
+
+// Calls onField(key, cursor) for each member; onField consumes the value
+template <typename OnField>
+bool forEachField(Cursor& c, OnField onField) {
+    if (!c.consume('{')) return false;
+    if (c.consume('}')) return true;
+    do {
+        std::string_view key;
+        if (!readPlainString(c, key) || !c.consume(':') || !onField(key, c)) return false;
+    } while (c.consume(','));
+    return c.consume('}');
+}
+
+bool readOptionalString(Cursor& c, std::string_view& out) {
+    if (c.peek('"')) return readPlainString(c, out);
+    return skipValue(c);  // null or anything else reads as "not sent"
+}
+
+bool parseParams(std::string_view params, JobFields& job) {
+    Cursor c{params.data(), params.data() + params.size()};
+    bool hasHeight = false;
+    job = JobFields();
+    bool ok = forEachField(c, [&](std::string_view key, Cursor& value) {
+        if (key == "blob") return readPlainString(value, job.blob);
+        if (key == "job_id") return readPlainString(value, job.jobId);
+        if (key == "target") return readPlainString(value, job.target);
+        if (key == "seed_hash") return readPlainString(value, job.seedHash);
+        if (key == "next_seed_hash") return readOptionalString(value, job.nextSeedHash);
+        if (key == "algo") return readOptionalString(value, job.algo);
+        if (key == "height") {
+            hasHeight = readUnsigned(value, job.height);
+            return hasHeight;
+        }
+        return skipValue(value);
+    });
+    return ok && hasHeight && !job.blob.empty() && !job.jobId.empty() &&
+           !job.target.empty() && !job.seedHash.empty();
+}
+
+}
+
+bool parseJobNotification(std::string_view line, JobFields& job) {
+    Cursor c{line.data(), line.data() + line.size()};
+    std::string_view method;
+    std::string_view params;
+    bool ok = forEachField(c, [&](std::string_view key, Cursor& value) {
+        if (key == "method") return readPlainString(value, method);
+        if (key == "params") {
+            // Members can come in any order; decode params once method is known
+            value.skipSpace();
+            const char* start = value.pos;
+            if (!skipValue(value)) return false;
+            params = std::string_view(start, static_cast<size_t>(value.pos - start));
+            return true;
+        }
+        return skipValue(value);
+    });
+    c.skipSpace();
+    if (!ok || c.pos != c.end || method != "job" || params.empty() || params.front() != '{') {
+        return false;
+    }
+    return parseParams(params, job);
+}
+
+}
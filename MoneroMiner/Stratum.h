@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+// Fast path for the one message that matters for latency: the pool's job
+// push. A job has a fixed, tiny schema, so it is decoded in a single pass
+// over the received line without building a JSON tree - strings come back
+// as views into the line and height is read as an integer. Anything this
+// decoder does not recognize (other methods, replies, escaped or missing
+// fields, fractional numbers) is left to picojson.
+namespace Stratum {
+    // Fields of a "job" notification, valid as long as the line is
+    struct JobFields {
+        std::string_view blob;
+        std::string_view jobId;
+        std::string_view target;
+        std::string_view seedHash;
+        std::string_view nextSeedHash;  // Empty if not announced
+        std::string_view algo;          // Empty if the pool does not send it
+        uint64_t height = 0;
+    };
+
+    // True only for a well-formed {"method":"job","params":{...}} line with
+    // every required field; false means "use the generic parser"
+    bool parseJobNotification(std::string_view line, JobFields& job);
+}
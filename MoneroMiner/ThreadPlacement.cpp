@@ -0,0 +1,86 @@
+#include "ThreadPlacement.h"
+#include <algorithm>
+#include <sstream>
+
+namespace ThreadPlacement {
+
+namespace {
+    size_t domainBudget(const Platform::CacheDomain& domain) {
+        return (std::min)(static_cast<size_t>(domain.sizeBytes / SCRATCHPAD_BYTES), domain.cpus.size());
+    }
+
+    // Each domain's CPUs, first threads of cores before SMT siblings. CPUs
+    // without L3 information form one extra domain with an unlimited budget.
+    std::vector<std::vector<const Platform::LogicalCpu*>> cpusByDomain(const Platform::CpuTopology& topology) {
+        std::vector<std::vector<const Platform::LogicalCpu*>> domains(topology.l3Domains.size() + 1);
+        for (const Platform::LogicalCpu& cpu : topology.cpus) {
+            size_t domain = cpu.l3Domain >= 0 && static_cast<size_t>(cpu.l3Domain) < topology.l3Domains.size()
+                ? static_cast<size_t>(cpu.l3Domain) : topology.l3Domains.size();
+            domains[domain].push_back(&cpu);
+        }
+        for (auto& cpus : domains) {
+            std::stable_sort(cpus.begin(), cpus.end(), [](const Platform::LogicalCpu* a, const Platform::LogicalCpu* b) {
+                if (a->smtIndex != b->smtIndex) return a->smtIndex < b->smtIndex;
+                if (a->package != b->package) return a->package < b->package;
+                return a->core < b->core;
+            });
+        }
+        return domains;
+    }
+}
+
+size_t recommendedThreads(const Platform::CpuTopology& topology) {
+    size_t threads = 0;
+    for (const Platform::CacheDomain& domain : topology.l3Domains) {
+        threads += domainBudget(domain);
+    }
+    return threads;
+}
+
+std::vector<unsigned int> plan(const Platform::CpuTopology& topology, size_t threadCount) {
+    auto domains = cpusByDomain(topology);
+
+    // Within budget first, then the rest; domains take turns in both rounds
+    std::vector<unsigned int> order;
+    for (int round = 0; round < 2; round++) {
+        std::vector<size_t> next(domains.size(), 0);
+        bool added = true;
+        while (added) {
+            added = false;
+            for (size_t d = 0; d < domains.size(); d++) {
+                size_t budget = d < topology.l3Domains.size() ? domainBudget(topology.l3Domains[d]) : domains[d].size();
+                size_t first = round == 0 ? 0 : budget;
+                size_t last = round == 0 ? budget : domains[d].size();
+                if (first + next[d] < last) {
+                    order.push_back(domains[d][first + next[d]]->id);
+                    next[d]++;
+                    added = true;
+                }
+            }
+        }
+    }
+
+    std::vector<unsigned int> threadCpus;
+    for (size_t i = 0; i < threadCount && !order.empty(); i++) {
+        threadCpus.push_back(order[i % order.size()]);
+    }
+    return threadCpus;
+}
+
+std::string describe(const Platform::CpuTopology& topology, const std::vector<unsigned int>& threadCpus) {
+    std::stringstream ss;
+    ss << "Thread placement:";
+    for (size_t i = 0; i < threadCpus.size(); i++) {
+        ss << " T" << i << "->" << threadCpus[i];
+    }
+    if (!topology.l3Domains.empty()) {
+        ss << " | L3:";
+        for (const Platform::CacheDomain& domain : topology.l3Domains) {
+            ss << " " << (domain.sizeBytes >> 20) << " MiB/" << domain.cpus.size() << " CPUs";
+        }
+        ss << " (budget " << recommendedThreads(topology) << " threads)";
+    }
+    return ss.str();
+}
+
+} // namespace ThreadPlacement
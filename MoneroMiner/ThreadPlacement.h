@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Platform.h"
+
+// Where mining threads run. Each RandomX VM keeps a 2 MiB scratchpad that
+// has to stay in L3, so an L3 domain (CCX, die or socket) feeds at most
+// size / 2 MiB threads. Within that budget physical cores are used before
+// their SMT siblings, and domains are filled in turn.
+namespace ThreadPlacement {
+    constexpr uint64_t SCRATCHPAD_BYTES = 2ull << 20;
+
+    // Threads the L3 caches can feed, 0 if the topology reports no L3
+    size_t recommendedThreads(const Platform::CpuTopology& topology);
+
+    // One CPU per thread. Past the L3 budget the remaining CPUs are handed
+    // out in the same order, and past the CPU count the plan wraps around.
+    std::vector<unsigned int> plan(const Platform::CpuTopology& topology, size_t threadCount);
+
+    // "T0->0 T1->2 ..." plus the L3 domains, for the startup log
+    std::string describe(const Platform::CpuTopology& topology, const std::vector<unsigned int>& threadCpus);
+}
\ No newline at end of file
@@ -41,6 +41,25 @@ std::vector<uint8_t> Utils::hexToBytes(const std::string& hex) {
     return bytes;
 }
 
+static int hexDigit(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+size_t Utils::hexToBytes(std::string_view hex, uint8_t* out, size_t capacity) {
+    size_t size = hex.size() / 2;
+    if (hex.size() % 2 != 0 || size > capacity) return 0;
+    for (size_t i = 0; i < size; i++) {
+        int high = hexDigit(hex[2 * i]);
+        int low = hexDigit(hex[2 * i + 1]);
+        if (high < 0 || low < 0) return 0;
+        out[i] = static_cast<uint8_t>((high << 4) | low);
+    }
+    return size;
+}
+
 std::string Utils::bytesToHex(const uint8_t* data, size_t len) {
     std::stringstream ss;
     ss << std::hex << std::setfill('0');
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <cstdint>
 #include <vector>
 
@@ -8,6 +9,8 @@ class Utils {
 public:
     // Hex conversion
     static std::vector<uint8_t> hexToBytes(const std::string& hex);
+    // Into a caller buffer without allocating; 0 if odd, non-hex or over capacity
+    static size_t hexToBytes(std::string_view hex, uint8_t* out, size_t capacity);
     static std::string bytesToHex(const std::vector<uint8_t>& bytes);
     static std::string bytesToHex(const uint8_t* data, size_t len);
     static std::string formatHex(uint64_t value, int width);
@@ -52,6 +52,8 @@ typedef int randomx_flags;
 #define RANDOMX_FLAG_ARGON2_SSSE3 32
 #define RANDOMX_FLAG_ARGON2_AVX2 64
 #define RANDOMX_FLAG_ARGON2 96
+#define RANDOMX_FLAG_1GB_PAGES 128
+#define RANDOMX_FLAG_THP 256
 
 struct randomx_dataset;
 struct randomx_cache;
@@ -80,6 +82,7 @@ RANDOMX_EXPORT void randomx_calculate_commitment(const void* input, size_t input
 RANDOMX_EXPORT randomx_flags randomx_get_flags(void);
 RANDOMX_EXPORT unsigned long randomx_dataset_item_count(void);
 RANDOMX_EXPORT void* randomx_get_dataset_memory(randomx_dataset* dataset);
+RANDOMX_EXPORT size_t randomx_get_dataset_page_size(randomx_dataset* dataset);
 #else
 RANDOMX_EXPORT struct randomx_cache* randomx_alloc_cache(randomx_flags flags);
 RANDOMX_EXPORT void randomx_init_cache(struct randomx_cache* cache, const void* key, size_t keySize);
@@ -99,6 +102,7 @@ RANDOMX_EXPORT void randomx_calculate_commitment(const void* input, size_t input
 RANDOMX_EXPORT randomx_flags randomx_get_flags(void);
 RANDOMX_EXPORT unsigned long randomx_dataset_item_count(void);
 RANDOMX_EXPORT void* randomx_get_dataset_memory(struct randomx_dataset* dataset);
+RANDOMX_EXPORT size_t randomx_get_dataset_page_size(struct randomx_dataset* dataset);
 #endif
 
 #ifdef __cplusplus
@@ -0,0 +1,21 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/RandomX/src/tests/affinity.cpp" "CMakeFiles/randomx-benchmark.dir/src/tests/affinity.cpp.o" "gcc" "CMakeFiles/randomx-benchmark.dir/src/tests/affinity.cpp.o.d"
+  "/root/repo/RandomX/src/tests/benchmark.cpp" "CMakeFiles/randomx-benchmark.dir/src/tests/benchmark.cpp.o" "gcc" "CMakeFiles/randomx-benchmark.dir/src/tests/benchmark.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/RandomX/build/CMakeFiles/randomx.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/randomx-benchmark.dir/src/tests/affinity.cpp.o"
+  "CMakeFiles/randomx-benchmark.dir/src/tests/affinity.cpp.o.d"
+  "CMakeFiles/randomx-benchmark.dir/src/tests/benchmark.cpp.o"
+  "CMakeFiles/randomx-benchmark.dir/src/tests/benchmark.cpp.o.d"
+  "randomx-benchmark"
+  "randomx-benchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/randomx-benchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
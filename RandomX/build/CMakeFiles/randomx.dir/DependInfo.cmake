@@ -0,0 +1,44 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/RandomX/src/argon2_avx2.c" "CMakeFiles/randomx.dir/src/argon2_avx2.c.o" "gcc" "CMakeFiles/randomx.dir/src/argon2_avx2.c.o.d"
+  "/root/repo/RandomX/src/argon2_core.c" "CMakeFiles/randomx.dir/src/argon2_core.c.o" "gcc" "CMakeFiles/randomx.dir/src/argon2_core.c.o.d"
+  "/root/repo/RandomX/src/argon2_ref.c" "CMakeFiles/randomx.dir/src/argon2_ref.c.o" "gcc" "CMakeFiles/randomx.dir/src/argon2_ref.c.o.d"
+  "/root/repo/RandomX/src/argon2_ssse3.c" "CMakeFiles/randomx.dir/src/argon2_ssse3.c.o" "gcc" "CMakeFiles/randomx.dir/src/argon2_ssse3.c.o.d"
+  "/root/repo/RandomX/src/blake2/blake2b.c" "CMakeFiles/randomx.dir/src/blake2/blake2b.c.o" "gcc" "CMakeFiles/randomx.dir/src/blake2/blake2b.c.o.d"
+  "/root/repo/RandomX/src/jit_compiler_x86_static.S" "CMakeFiles/randomx.dir/src/jit_compiler_x86_static.S.o" "gcc" "CMakeFiles/randomx.dir/src/jit_compiler_x86_static.S.o.d"
+  "/root/repo/RandomX/src/reciprocal.c" "CMakeFiles/randomx.dir/src/reciprocal.c.o" "gcc" "CMakeFiles/randomx.dir/src/reciprocal.c.o.d"
+  "/root/repo/RandomX/src/virtual_memory.c" "CMakeFiles/randomx.dir/src/virtual_memory.c.o" "gcc" "CMakeFiles/randomx.dir/src/virtual_memory.c.o.d"
+  "/root/repo/RandomX/src/aes_hash.cpp" "CMakeFiles/randomx.dir/src/aes_hash.cpp.o" "gcc" "CMakeFiles/randomx.dir/src/aes_hash.cpp.o.d"
+  "/root/repo/RandomX/src/allocator.cpp" "CMakeFiles/randomx.dir/src/allocator.cpp.o" "gcc" "CMakeFiles/randomx.dir/src/allocator.cpp.o.d"
+  "/root/repo/RandomX/src/assembly_generator_x86.cpp" "CMakeFiles/randomx.dir/src/assembly_generator_x86.cpp.o" "gcc" "CMakeFiles/randomx.dir/src/assembly_generator_x86.cpp.o.d"
+  "/root/repo/RandomX/src/blake2_generator.cpp" "CMakeFiles/randomx.dir/src/blake2_generator.cpp.o" "gcc" "CMakeFiles/randomx.dir/src/blake2_generator.cpp.o.d"
+  "/root/repo/RandomX/src/bytecode_machine.cpp" "CMakeFiles/randomx.dir/src/bytecode_machine.cpp.o" "gcc" "CMakeFiles/randomx.dir/src/bytecode_machine.cpp.o.d"
+  "/root/repo/RandomX/src/cpu.cpp" "CMakeFiles/randomx.dir/src/cpu.cpp.o" "gcc" "CMakeFiles/randomx.dir/src/cpu.cpp.o.d"
+  "/root/repo/RandomX/src/dataset.cpp" "CMakeFiles/randomx.dir/src/dataset.cpp.o" "gcc" "CMakeFiles/randomx.dir/src/dataset.cpp.o.d"
+  "/root/repo/RandomX/src/instruction.cpp" "CMakeFiles/randomx.dir/src/instruction.cpp.o" "gcc" "CMakeFiles/randomx.dir/src/instruction.cpp.o.d"
+  "/root/repo/RandomX/src/instructions_portable.cpp" "CMakeFiles/randomx.dir/src/instructions_portable.cpp.o" "gcc" "CMakeFiles/randomx.dir/src/instructions_portable.cpp.o.d"
+  "/root/repo/RandomX/src/jit_compiler_x86.cpp" "CMakeFiles/randomx.dir/src/jit_compiler_x86.cpp.o" "gcc" "CMakeFiles/randomx.dir/src/jit_compiler_x86.cpp.o.d"
+  "/root/repo/RandomX/src/randomx.cpp" "CMakeFiles/randomx.dir/src/randomx.cpp.o" "gcc" "CMakeFiles/randomx.dir/src/randomx.cpp.o.d"
+  "/root/repo/RandomX/src/soft_aes.cpp" "CMakeFiles/randomx.dir/src/soft_aes.cpp.o" "gcc" "CMakeFiles/randomx.dir/src/soft_aes.cpp.o.d"
+  "/root/repo/RandomX/src/superscalar.cpp" "CMakeFiles/randomx.dir/src/superscalar.cpp.o" "gcc" "CMakeFiles/randomx.dir/src/superscalar.cpp.o.d"
+  "/root/repo/RandomX/src/virtual_machine.cpp" "CMakeFiles/randomx.dir/src/virtual_machine.cpp.o" "gcc" "CMakeFiles/randomx.dir/src/virtual_machine.cpp.o.d"
+  "/root/repo/RandomX/src/vm_compiled.cpp" "CMakeFiles/randomx.dir/src/vm_compiled.cpp.o" "gcc" "CMakeFiles/randomx.dir/src/vm_compiled.cpp.o.d"
+  "/root/repo/RandomX/src/vm_compiled_light.cpp" "CMakeFiles/randomx.dir/src/vm_compiled_light.cpp.o" "gcc" "CMakeFiles/randomx.dir/src/vm_compiled_light.cpp.o.d"
+  "/root/repo/RandomX/src/vm_interpreted.cpp" "CMakeFiles/randomx.dir/src/vm_interpreted.cpp.o" "gcc" "CMakeFiles/randomx.dir/src/vm_interpreted.cpp.o.d"
+  "/root/repo/RandomX/src/vm_interpreted_light.cpp" "CMakeFiles/randomx.dir/src/vm_interpreted_light.cpp.o" "gcc" "CMakeFiles/randomx.dir/src/vm_interpreted_light.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
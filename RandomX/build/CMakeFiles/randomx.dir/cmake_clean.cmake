@@ -0,0 +1,61 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/randomx.dir/src/aes_hash.cpp.o"
+  "CMakeFiles/randomx.dir/src/aes_hash.cpp.o.d"
+  "CMakeFiles/randomx.dir/src/allocator.cpp.o"
+  "CMakeFiles/randomx.dir/src/allocator.cpp.o.d"
+  "CMakeFiles/randomx.dir/src/argon2_avx2.c.o"
+  "CMakeFiles/randomx.dir/src/argon2_avx2.c.o.d"
+  "CMakeFiles/randomx.dir/src/argon2_core.c.o"
+  "CMakeFiles/randomx.dir/src/argon2_core.c.o.d"
+  "CMakeFiles/randomx.dir/src/argon2_ref.c.o"
+  "CMakeFiles/randomx.dir/src/argon2_ref.c.o.d"
+  "CMakeFiles/randomx.dir/src/argon2_ssse3.c.o"
+  "CMakeFiles/randomx.dir/src/argon2_ssse3.c.o.d"
+  "CMakeFiles/randomx.dir/src/assembly_generator_x86.cpp.o"
+  "CMakeFiles/randomx.dir/src/assembly_generator_x86.cpp.o.d"
+  "CMakeFiles/randomx.dir/src/blake2/blake2b.c.o"
+  "CMakeFiles/randomx.dir/src/blake2/blake2b.c.o.d"
+  "CMakeFiles/randomx.dir/src/blake2_generator.cpp.o"
+  "CMakeFiles/randomx.dir/src/blake2_generator.cpp.o.d"
+  "CMakeFiles/randomx.dir/src/bytecode_machine.cpp.o"
+  "CMakeFiles/randomx.dir/src/bytecode_machine.cpp.o.d"
+  "CMakeFiles/randomx.dir/src/cpu.cpp.o"
+  "CMakeFiles/randomx.dir/src/cpu.cpp.o.d"
+  "CMakeFiles/randomx.dir/src/dataset.cpp.o"
+  "CMakeFiles/randomx.dir/src/dataset.cpp.o.d"
+  "CMakeFiles/randomx.dir/src/instruction.cpp.o"
+  "CMakeFiles/randomx.dir/src/instruction.cpp.o.d"
+  "CMakeFiles/randomx.dir/src/instructions_portable.cpp.o"
+  "CMakeFiles/randomx.dir/src/instructions_portable.cpp.o.d"
+  "CMakeFiles/randomx.dir/src/jit_compiler_x86.cpp.o"
+  "CMakeFiles/randomx.dir/src/jit_compiler_x86.cpp.o.d"
+  "CMakeFiles/randomx.dir/src/jit_compiler_x86_static.S.o"
+  "CMakeFiles/randomx.dir/src/jit_compiler_x86_static.S.o.d"
+  "CMakeFiles/randomx.dir/src/randomx.cpp.o"
+  "CMakeFiles/randomx.dir/src/randomx.cpp.o.d"
+  "CMakeFiles/randomx.dir/src/reciprocal.c.o"
+  "CMakeFiles/randomx.dir/src/reciprocal.c.o.d"
+  "CMakeFiles/randomx.dir/src/soft_aes.cpp.o"
+  "CMakeFiles/randomx.dir/src/soft_aes.cpp.o.d"
+  "CMakeFiles/randomx.dir/src/superscalar.cpp.o"
+  "CMakeFiles/randomx.dir/src/superscalar.cpp.o.d"
+  "CMakeFiles/randomx.dir/src/virtual_machine.cpp.o"
+  "CMakeFiles/randomx.dir/src/virtual_machine.cpp.o.d"
+  "CMakeFiles/randomx.dir/src/virtual_memory.c.o"
+  "CMakeFiles/randomx.dir/src/virtual_memory.c.o.d"
+  "CMakeFiles/randomx.dir/src/vm_compiled.cpp.o"
+  "CMakeFiles/randomx.dir/src/vm_compiled.cpp.o.d"
+  "CMakeFiles/randomx.dir/src/vm_compiled_light.cpp.o"
+  "CMakeFiles/randomx.dir/src/vm_compiled_light.cpp.o.d"
+  "CMakeFiles/randomx.dir/src/vm_interpreted.cpp.o"
+  "CMakeFiles/randomx.dir/src/vm_interpreted.cpp.o.d"
+  "CMakeFiles/randomx.dir/src/vm_interpreted_light.cpp.o"
+  "CMakeFiles/randomx.dir/src/vm_interpreted_light.cpp.o.d"
+  "librandomx.a"
+  "librandomx.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C CXX)
+  include(CMakeFiles/randomx.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -60,4 +60,26 @@ namespace randomx {
 		freePagedMemory(ptr, count);
 	};
 
+	void* GigaPageAllocator::allocMemory(size_t count) {
+		void *mem = allocGigaPagesMemory(count);
+		if (mem == nullptr)
+			throw std::bad_alloc();
+		return mem;
+	}
+
+	void GigaPageAllocator::freeMemory(void* ptr, size_t count) {
+		freePagedMemory(ptr, alignSize(count, GIGA_PAGE_SIZE));
+	};
+
+	void* TransparentHugePageAllocator::allocMemory(size_t count) {
+		void *mem = allocTransparentHugePagesMemory(count);
+		if (mem == nullptr)
+			throw std::bad_alloc();
+		return mem;
+	}
+
+	void TransparentHugePageAllocator::freeMemory(void* ptr, size_t count) {
+		freePagedMemory(ptr, alignSize(count, LARGE_PAGE_SIZE));
+	};
+
 }
@@ -43,4 +43,14 @@ namespace randomx {
 		static void freeMemory(void*, size_t);
 	};
 
+	struct GigaPageAllocator {
+		static void* allocMemory(size_t);
+		static void freeMemory(void*, size_t);
+	};
+
+	struct TransparentHugePageAllocator {
+		static void* allocMemory(size_t);
+		static void freeMemory(void*, size_t);
+	};
+
 }
\ No newline at end of file
@@ -40,6 +40,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 struct randomx_dataset {
 	uint8_t* memory = nullptr;
 	randomx::DatasetDeallocFunc* dealloc;
+	size_t pageSize = 0;
 };
 
 /* Global scope for C binding */
@@ -34,8 +34,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "vm_compiled_light.hpp"
 #include "blake2/blake2.h"
 #include "cpu.hpp"
+#include "virtual_memory.h"
 #include <cassert>
 #include <limits>
+#include <new>
 
 #if defined(__SSE__) || defined(__SSE2__) || (defined(_M_IX86_FP) && (_M_IX86_FP > 0))
 #define USE_CSR_INTRINSICS
@@ -44,6 +46,23 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <cfenv>
 #endif
 
+namespace randomx {
+
+	template<class Allocator>
+	static bool allocDatasetMemory(randomx_dataset *dataset, size_t pageSize) {
+		try {
+			dataset->memory = (uint8_t*)Allocator::allocMemory(DatasetSize);
+		}
+		catch (std::bad_alloc&) {
+			return false;
+		}
+		dataset->dealloc = &deallocDataset<Allocator>;
+		dataset->pageSize = pageSize;
+		return true;
+	}
+
+}
+
 extern "C" {
 
 	randomx_flags randomx_get_flags() {
@@ -156,27 +175,25 @@ extern "C" {
 			return nullptr;
 		}
 
-		randomx_dataset *dataset = nullptr;
+		randomx_dataset *dataset = new (std::nothrow) randomx_dataset();
+		if (dataset == nullptr) {
+			return nullptr;
+		}
 
-		try {
-			dataset = new randomx_dataset();
-			if (flags & RANDOMX_FLAG_LARGE_PAGES) {
-				dataset->dealloc = &randomx::deallocDataset<randomx::LargePageAllocator>;
-				dataset->memory = (uint8_t*)randomx::LargePageAllocator::allocMemory(randomx::DatasetSize);
-			}
-			else {
-				dataset->dealloc = &randomx::deallocDataset<randomx::DefaultAllocator>;
-				dataset->memory = (uint8_t*)randomx::DefaultAllocator::allocMemory(randomx::DatasetSize);
-			}
+		//largest pages first, each step falls back to the next one the flags allow;
+		//a failed RANDOMX_FLAG_LARGE_PAGES request without RANDOMX_FLAG_THP still fails
+		bool allocated = (flags & RANDOMX_FLAG_1GB_PAGES) && randomx::allocDatasetMemory<randomx::GigaPageAllocator>(dataset, GIGA_PAGE_SIZE);
+		if (!allocated && (flags & RANDOMX_FLAG_LARGE_PAGES)) {
+			allocated = randomx::allocDatasetMemory<randomx::LargePageAllocator>(dataset, LARGE_PAGE_SIZE);
 		}
-		catch (std::exception &ex) {
-			if (dataset != nullptr) {
-				randomx_release_dataset(dataset);
-				dataset = nullptr;
-			}
+		if (!allocated && (flags & RANDOMX_FLAG_THP)) {
+			allocated = randomx::allocDatasetMemory<randomx::TransparentHugePageAllocator>(dataset, 0);
 		}
-		if (dataset && dataset->memory == nullptr) {
-			randomx_release_dataset(dataset);
+		if (!allocated && !(flags & RANDOMX_FLAG_LARGE_PAGES)) {
+			allocated = randomx::allocDatasetMemory<randomx::DefaultAllocator>(dataset, 0);
+		}
+		if (!allocated) {
+			delete dataset;
 			dataset = nullptr;
 		}
 
@@ -202,6 +219,11 @@ extern "C" {
 		return dataset->memory;
 	}
 
+	size_t randomx_get_dataset_page_size(randomx_dataset *dataset) {
+		assert(dataset != nullptr);
+		return dataset->pageSize;
+	}
+
 	void randomx_release_dataset(randomx_dataset *dataset) {
 		assert(dataset != nullptr);
 		dataset->dealloc(dataset);
@@ -48,7 +48,9 @@ typedef enum {
   RANDOMX_FLAG_SECURE = 16,
   RANDOMX_FLAG_ARGON2_SSSE3 = 32,
   RANDOMX_FLAG_ARGON2_AVX2 = 64,
-  RANDOMX_FLAG_ARGON2 = 96
+  RANDOMX_FLAG_ARGON2 = 96,
+  RANDOMX_FLAG_1GB_PAGES = 128,
+  RANDOMX_FLAG_THP = 256
 } randomx_flags;
 
 typedef struct randomx_dataset randomx_dataset;
@@ -177,6 +179,15 @@ RANDOMX_EXPORT void randomx_init_dataset(randomx_dataset *dataset, randomx_cache
 */
 RANDOMX_EXPORT void *randomx_get_dataset_memory(randomx_dataset *dataset);
 
+/**
+ * Returns the size of the huge pages backing the dataset memory: 1 GiB when
+ * RANDOMX_FLAG_1GB_PAGES succeeded, 2 MiB for RANDOMX_FLAG_LARGE_PAGES, 0 for normal pages.
+ * Memory allocated with RANDOMX_FLAG_THP reports 0 because the kernel decides per page.
+ *
+ * @param dataset is a pointer to a previously allocated randomx_dataset structure. Must not be NULL.
+*/
+RANDOMX_EXPORT size_t randomx_get_dataset_page_size(randomx_dataset *dataset);
+
 /**
  * Releases all memory occupied by the randomx_dataset structure.
  *
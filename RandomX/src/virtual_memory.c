@@ -225,19 +225,50 @@ void* allocLargePagesMemory(size_t bytes) {
 #elif defined(__OpenBSD__) || defined(__NetBSD__)
 	mem = MAP_FAILED; // OpenBSD does not support huge pages
 #else
-	// Try 1GB pages first if available (Linux only)
-	mem = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | (30 << MAP_HUGE_SHIFT) | MAP_POPULATE, -1, 0);
-	if (mem == MAP_FAILED) {
-		// Fall back to 2MB pages
-		mem = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | MAP_POPULATE, -1, 0);
-	}
+	mem = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | MAP_POPULATE, -1, 0);
+#endif
+	if (mem == MAP_FAILED)
+		mem = NULL;
 #endif
+	return mem;
+}
+
+/* 1 GiB pages (Linux only). The mapping is rounded up to whole pages, so it
+ * must be released with freePagedMemory(ptr, alignSize(bytes, GIGA_PAGE_SIZE)). */
+void* allocGigaPagesMemory(size_t bytes) {
+	void* mem = NULL;
+#if defined(__linux__) && defined(MAP_HUGETLB) && defined(MAP_HUGE_SHIFT)
+	mem = mmap(NULL, alignSize(bytes, GIGA_PAGE_SIZE), PROT_READ | PROT_WRITE,
+		MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | (30 << MAP_HUGE_SHIFT) | MAP_POPULATE, -1, 0);
 	if (mem == MAP_FAILED)
 		mem = NULL;
 #endif
 	return mem;
 }
 
+/* Normal pages, 2 MiB aligned and marked MADV_HUGEPAGE so the kernel can back them with
+ * transparent huge pages without a reserved pool (Linux only). The mapping is rounded up
+ * to whole 2 MiB pages, so it must be released with alignSize(bytes, LARGE_PAGE_SIZE). */
+void* allocTransparentHugePagesMemory(size_t bytes) {
+	void* mem = NULL;
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+	size_t size = alignSize(bytes, LARGE_PAGE_SIZE);
+	char* raw = (char*)mmap(NULL, size + LARGE_PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (raw == MAP_FAILED)
+		return NULL;
+	// Trim the over-allocation so the mapping starts on a 2 MiB boundary
+	size_t head = (LARGE_PAGE_SIZE - ((size_t)raw & (LARGE_PAGE_SIZE - 1))) & (LARGE_PAGE_SIZE - 1);
+	if (head)
+		munmap(raw, head);
+	if (LARGE_PAGE_SIZE - head)
+		munmap(raw + head + size, LARGE_PAGE_SIZE - head);
+	mem = raw + head;
+	// Advisory only: without THP the memory is still usable on normal pages
+	madvise(mem, size, MADV_HUGEPAGE);
+#endif
+	return mem;
+}
+
 void freePagedMemory(void* ptr, size_t bytes) {
 #if defined(_WIN32) || defined(__CYGWIN__)
 	VirtualFree(ptr, 0, MEM_RELEASE);
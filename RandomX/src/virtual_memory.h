@@ -35,12 +35,16 @@ extern "C" {
 #include <stddef.h>
 
 #define alignSize(pos, align) (((pos - 1) / align + 1) * align)
+#define LARGE_PAGE_SIZE ((size_t)2 << 20)
+#define GIGA_PAGE_SIZE ((size_t)1 << 30)
 
 void* allocMemoryPages(size_t);
 void setPagesRW(void*, size_t);
 void setPagesRX(void*, size_t);
 void setPagesRWX(void*, size_t);
 void* allocLargePagesMemory(size_t);
+void* allocGigaPagesMemory(size_t);
+void* allocTransparentHugePagesMemory(size_t);
 void freePagedMemory(void*, size_t);
 
 #ifdef __cplusplus
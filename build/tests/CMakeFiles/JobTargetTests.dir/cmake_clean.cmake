@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/JobTargetTests.dir/JobTargetTests.cpp.o"
+  "CMakeFiles/JobTargetTests.dir/JobTargetTests.cpp.o.d"
+  "JobTargetTests"
+  "JobTargetTests.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/JobTargetTests.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ShareReplayTests.dir/ShareReplayTests.cpp.o"
+  "CMakeFiles/ShareReplayTests.dir/ShareReplayTests.cpp.o.d"
+  "ShareReplayTests"
+  "ShareReplayTests.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ShareReplayTests.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,38 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/MoneroMiner/AllocationCounter.cpp" "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/AllocationCounter.cpp.o" "gcc" "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/AllocationCounter.cpp.o.d"
+  "/root/repo/MoneroMiner/Benchmark.cpp" "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/Benchmark.cpp.o" "gcc" "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/Benchmark.cpp.o.d"
+  "/root/repo/MoneroMiner/Config.cpp" "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/Config.cpp.o" "gcc" "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/Config.cpp.o.d"
+  "/root/repo/MoneroMiner/DatasetStore.cpp" "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/DatasetStore.cpp.o" "gcc" "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/DatasetStore.cpp.o.d"
+  "/root/repo/MoneroMiner/Difficulty.cpp" "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/Difficulty.cpp.o" "gcc" "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/Difficulty.cpp.o.d"
+  "/root/repo/MoneroMiner/EventLoop.cpp" "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/EventLoop.cpp.o" "gcc" "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/EventLoop.cpp.o.d"
+  "/root/repo/MoneroMiner/Globals.cpp" "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/Globals.cpp.o" "gcc" "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/Globals.cpp.o.d"
+  "/root/repo/MoneroMiner/Job.cpp" "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/Job.cpp.o" "gcc" "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/Job.cpp.o.d"
+  "/root/repo/MoneroMiner/LineBuffer.cpp" "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/LineBuffer.cpp.o" "gcc" "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/LineBuffer.cpp.o.d"
+  "/root/repo/MoneroMiner/MiningStats.cpp" "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/MiningStats.cpp.o" "gcc" "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/MiningStats.cpp.o.d"
+  "/root/repo/MoneroMiner/MiningThreadData.cpp" "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/MiningThreadData.cpp.o" "gcc" "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/MiningThreadData.cpp.o.d"
+  "/root/repo/MoneroMiner/NonceDispenser.cpp" "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/NonceDispenser.cpp.o" "gcc" "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/NonceDispenser.cpp.o.d"
+  "/root/repo/MoneroMiner/Platform.cpp" "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/Platform.cpp.o" "gcc" "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/Platform.cpp.o.d"
+  "/root/repo/MoneroMiner/PoolClient.cpp" "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/PoolClient.cpp.o" "gcc" "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/PoolClient.cpp.o.d"
+  "/root/repo/MoneroMiner/RandomXManager.cpp" "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/RandomXManager.cpp.o" "gcc" "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/RandomXManager.cpp.o.d"
+  "/root/repo/MoneroMiner/ShareQueue.cpp" "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/ShareQueue.cpp.o" "gcc" "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/ShareQueue.cpp.o.d"
+  "/root/repo/MoneroMiner/Stratum.cpp" "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/Stratum.cpp.o" "gcc" "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/Stratum.cpp.o.d"
+  "/root/repo/MoneroMiner/ThreadPlacement.cpp" "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/ThreadPlacement.cpp.o" "gcc" "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/ThreadPlacement.cpp.o.d"
+  "/root/repo/MoneroMiner/Utils.cpp" "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/Utils.cpp.o" "gcc" "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/Utils.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/build/tests/randomx/CMakeFiles/randomx.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
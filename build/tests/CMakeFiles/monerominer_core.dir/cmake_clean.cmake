@@ -0,0 +1,47 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/AllocationCounter.cpp.o"
+  "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/AllocationCounter.cpp.o.d"
+  "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/Benchmark.cpp.o"
+  "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/Benchmark.cpp.o.d"
+  "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/Config.cpp.o"
+  "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/Config.cpp.o.d"
+  "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/DatasetStore.cpp.o"
+  "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/DatasetStore.cpp.o.d"
+  "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/Difficulty.cpp.o"
+  "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/Difficulty.cpp.o.d"
+  "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/EventLoop.cpp.o"
+  "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/EventLoop.cpp.o.d"
+  "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/Globals.cpp.o"
+  "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/Globals.cpp.o.d"
+  "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/Job.cpp.o"
+  "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/Job.cpp.o.d"
+  "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/LineBuffer.cpp.o"
+  "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/LineBuffer.cpp.o.d"
+  "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/MiningStats.cpp.o"
+  "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/MiningStats.cpp.o.d"
+  "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/MiningThreadData.cpp.o"
+  "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/MiningThreadData.cpp.o.d"
+  "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/NonceDispenser.cpp.o"
+  "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/NonceDispenser.cpp.o.d"
+  "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/Platform.cpp.o"
+  "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/Platform.cpp.o.d"
+  "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/PoolClient.cpp.o"
+  "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/PoolClient.cpp.o.d"
+  "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/RandomXManager.cpp.o"
+  "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/RandomXManager.cpp.o.d"
+  "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/ShareQueue.cpp.o"
+  "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/ShareQueue.cpp.o.d"
+  "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/Stratum.cpp.o"
+  "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/Stratum.cpp.o.d"
+  "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/ThreadPlacement.cpp.o"
+  "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/ThreadPlacement.cpp.o.d"
+  "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/Utils.cpp.o"
+  "CMakeFiles/monerominer_core.dir/root/repo/MoneroMiner/Utils.cpp.o.d"
+  "libmonerominer_core.a"
+  "libmonerominer_core.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/monerominer_core.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,3 @@
+file(REMOVE_RECURSE
+  "libmonerominer_core.a"
+)
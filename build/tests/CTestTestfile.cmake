@@ -0,0 +1,11 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/tests
+# Build directory: /root/repo/build/tests
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(JobTargetTests "/root/repo/build/tests/JobTargetTests")
+set_tests_properties(JobTargetTests PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;42;add_test;/root/repo/tests/CMakeLists.txt;45;miner_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(ShareReplayTests "/root/repo/build/tests/ShareReplayTests")
+set_tests_properties(ShareReplayTests PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;42;add_test;/root/repo/tests/CMakeLists.txt;46;miner_test;/root/repo/tests/CMakeLists.txt;0;")
+subdirs("randomx")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/randomx-codegen.dir/src/tests/code-generator.cpp.o"
+  "CMakeFiles/randomx-codegen.dir/src/tests/code-generator.cpp.o.d"
+  "randomx-codegen"
+  "randomx-codegen.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/randomx-codegen.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/randomx-tests.dir/src/tests/tests.cpp.o"
+  "CMakeFiles/randomx-tests.dir/src/tests/tests.cpp.o.d"
+  "randomx-tests"
+  "randomx-tests.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/randomx-tests.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
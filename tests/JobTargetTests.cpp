@@ -0,0 +1,106 @@
+// Boundary behavior of Job::meetsTarget: the fast reject on hash bytes 24..31
+// must never change the result of the full 256-bit "hash <= target" compare.
+
+#include "Job.h"
+#include "TestCheck.h"
+#include <array>
+#include <cstdint>
+#include <string>
+
+namespace {
+    using Words = std::array<uint64_t, 4>;  // Little-endian, [3] is the most significant
+    using Hash = std::array<uint8_t, 32>;
+
+    Hash toHash(const Words& words) {
+        Hash hash{};
+        for (int word = 0; word < 4; word++) {
+            for (int byte = 0; byte < 8; byte++) {
+                hash[word * 8 + byte] = static_cast<uint8_t>(words[word] >> (byte * 8));
+            }
+        }
+        return hash;
+    }
+
+    // words + delta as a 256-bit integer, carries/borrows included
+    Words add(Words words, int delta) {
+        for (int word = 0; word < 4; word++) {
+            uint64_t before = words[word];
+            words[word] += static_cast<uint64_t>(static_cast<int64_t>(delta));
+            bool carried = delta > 0 ? words[word] < before : words[word] > before;
+            if (!carried) break;
+        }
+        return words;
+    }
+
+    bool meets(const Words& hashWords, const Words& target) {
+        Hash hash = toHash(hashWords);
+        bool fast = Job::meetsTarget(hash.data(), target);
+        CHECK(fast == Job::fullCompare(hashWords, target));
+        return fast;
+    }
+
+    std::string littleEndianHex(uint64_t value, int bytes) {
+        static const char digits[] = "0123456789abcdef";
+        std::string hex;
+        for (int byte = 0; byte < bytes; byte++) {
+            uint8_t b = static_cast<uint8_t>(value >> (byte * 8));
+            hex += digits[b >> 4];
+            hex += digits[b & 0x0F];
+        }
+        return hex;
+    }
+
+    void checkBoundaries(const Words& target) {
+        CHECK(meets(target, target));               // Equal is a valid share
+        CHECK(!meets(add(target, 1), target));      // One above
+        CHECK(meets(add(target, -1), target));      // One below
+    }
+
+    void testBoundaries() {
+        // Plain target, and ones where +-1 carries or borrows across words
+        checkBoundaries({0x1234, 0x5678, 0x9abc, 0x00000000000022f3ULL});
+        checkBoundaries({0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL, 0, 0x22f3});
+        checkBoundaries({0, 0, 0, 0x22f3});
+
+        // Top word equal to target[3]: the fast path must not decide alone
+        Words target = {0, 0, 0, 0x22f3};
+        CHECK(meets({0, 0, 0, 0x22f3}, target));
+        CHECK(!meets({1, 0, 0, 0x22f3}, target));
+        CHECK(!meets({0, 0, 0, 0x22f4}, target));
+        CHECK(meets({0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL, 0x22f2}, target));
+
+        // Extremes
+        Words zero = {0, 0, 0, 0};
+        Words maximum = {~0ULL, ~0ULL, ~0ULL, ~0ULL};
+        CHECK(meets(zero, zero));
+        CHECK(!meets({1, 0, 0, 0}, zero));
+        CHECK(meets(maximum, maximum));
+    }
+
+    // A 4-byte compact target and the 8-byte target of the same difficulty
+    // give the same 256-bit target; an 8-byte one also reaches difficulties
+    // the compact form cannot express
+    void testTargetWidths() {
+        Job compact("", "a", "f3220000", 1, "");
+        CHECK(compact.difficulty == 480045);
+
+        Job wide("", "b", littleEndianHex(0xFFFFFFFFFFFFFFFFULL / 480045, 8), 1, "");
+        CHECK(wide.difficulty == compact.difficulty);
+        CHECK(wide.targetHash == compact.targetHash);
+        checkBoundaries(compact.targetHash);
+        checkBoundaries(wide.targetHash);
+
+        Job high("", "c", littleEndianHex(0xFFFFFFFFFFFFFFFFULL / 5000000000ULL, 8), 1, "");
+        CHECK(high.difficulty > 0xFFFFFFFFULL);
+        CHECK(high.targetHash[3] <= 0xFFFFFFFFULL);
+        checkBoundaries(high.targetHash);
+        CHECK(!meets({0, 0, 0, high.targetHash[3] + 1}, high.targetHash));
+        CHECK(!meets(compact.targetHash, high.targetHash));
+    }
+}
+
+int main() {
+    testBoundaries();
+    testTargetWidths();
+    return TEST_RESULT();
+}
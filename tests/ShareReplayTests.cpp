@@ -0,0 +1,74 @@
+// MiningThreadData::markShareSubmitted: a nonce queued twice for the same job
+// generation is suppressed locally, the ring forgets the oldest nonce once it
+// wraps past its 16 entries, and a new generation starts an empty ring.
+
+#include "MiningThreadData.h"
+#include "TestCheck.h"
+#include <cstdint>
+#include <memory>
+
+namespace {
+    constexpr uint32_t RING_SIZE = 16;
+
+    void testReplay() {
+        auto data = std::make_unique<MiningThreadData>(0);
+        CHECK(data->markShareSubmitted(1, 0x1000));
+        CHECK(!data->markShareSubmitted(1, 0x1000));  // Same job, same nonce
+        CHECK(!data->markShareSubmitted(1, 0x1000));
+        CHECK(data->markShareSubmitted(1, 0x1001));
+        CHECK(!data->markShareSubmitted(1, 0x1001));
+        CHECK(data->markShareSubmitted(1, 0));        // Nonce 0 is a nonce like any other
+        CHECK(!data->markShareSubmitted(1, 0));
+    }
+
+    void testRingWrap() {
+        auto data = std::make_unique<MiningThreadData>(0);
+        for (uint32_t nonce = 0; nonce < RING_SIZE; nonce++) {
+            CHECK(data->markShareSubmitted(7, 0x2000 + nonce));
+        }
+        // Full ring: every entry is still remembered
+        for (uint32_t nonce = 0; nonce < RING_SIZE; nonce++) {
+            CHECK(!data->markShareSubmitted(7, 0x2000 + nonce));
+        }
+
+        // The 17th share overwrites the oldest one only
+        CHECK(data->markShareSubmitted(7, 0x3000));
+        CHECK(data->markShareSubmitted(7, 0x2000));   // Forgotten, so accepted again
+        for (uint32_t nonce = 2; nonce < RING_SIZE; nonce++) {
+            CHECK(!data->markShareSubmitted(7, 0x2000 + nonce));
+        }
+        CHECK(!data->markShareSubmitted(7, 0x3000));
+
+        // Several laps later the ring still holds exactly the last 16 nonces
+        for (uint32_t nonce = 0; nonce < 5 * RING_SIZE + 3; nonce++) {
+            CHECK(data->markShareSubmitted(7, 0x4000 + nonce));
+        }
+        for (uint32_t nonce = 4 * RING_SIZE + 3; nonce < 5 * RING_SIZE + 3; nonce++) {
+            CHECK(!data->markShareSubmitted(7, 0x4000 + nonce));
+        }
+        CHECK(data->markShareSubmitted(7, 0x4000 + 4 * RING_SIZE + 2));
+    }
+
+    void testGenerationChange() {
+        auto data = std::make_unique<MiningThreadData>(0);
+        for (uint32_t nonce = 0; nonce < 4; nonce++) {
+            CHECK(data->markShareSubmitted(10, 0x5000 + nonce));
+        }
+
+        // A new job generation: the same nonces are new shares
+        CHECK(data->markShareSubmitted(11, 0x5000));
+        CHECK(!data->markShareSubmitted(11, 0x5000));
+
+        // ... and the previous generation's entries are gone
+        CHECK(data->markShareSubmitted(10, 0x5001));
+        CHECK(!data->markShareSubmitted(10, 0x5001));
+        CHECK(data->markShareSubmitted(10, 0x5000));
+    }
+}
+
+int main() {
+    testReplay();
+    testRingWrap();
+    testGenerationChange();
+    return TEST_RESULT();
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <iostream>
+
+// Minimal checks for the test programs: CHECK reports a failed condition and
+// carries on, TEST_RESULT() is what main() returns (non-zero on any failure)
+namespace TestCheck {
+    inline int& failures() {
+        static int count = 0;
+        return count;
+    }
+}
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK failed: " #condition << std::endl; \
+            ++TestCheck::failures(); \
+        } \
+    } while (0)
+
+#define TEST_RESULT() (TestCheck::failures() == 0 ? 0 : 1)